@@ -6,8 +6,14 @@
  	<tr><th>Name</th>                     <th>Value</th> <th>Description</th></tr>
  	<tr><td>SPAWNPOINT_Timer_Default</td> <td>1000</td>  <td>The default timer until an object respawns is this many frames.</td></tr>
  	<tr><td>SPAWNPOINT_Timer_Infinite</td> <td>-1</td>   <td>Use this value if you want the object to spawn only once, when the game starts.</td></tr>
-    <tr><td>SpawnPointEffectInterval()</td> <td>10</td>  <td>Defines how often the spawn point checks if the object should respawn, in frames.</td></tr>
+    <tr><td>SpawnPointEffectInterval()</td> <td>10</td>  <td>Defines the time grid for respawns and for {@c EffectTimer()}, in frames.</td></tr>
  </table>
+ {@section Scheduling}
+ Spawn points do not run a timer effect of their own. They register the frame in which an
+ object respawns with the {@link Arena_SpawnPointScheduler#index spawn point scheduler}, which calls
+ them back when the object is actually due. The respawn times are the same as with a timer
+ that runs every {@c SpawnPointEffectInterval()} frames, unless the spawn point is configured
+ with {@link SpawnPoint#SetExactTimer}.
 @title Spawnpoint
 @id index
 @author Marky
@@ -23,6 +29,16 @@ public func  SpawnPointEffectInterval(){return 10;}
 static const SPAWNPOINT_Effect_Collection = "IntSpawnCollect";
 public func  SpawnPointCollectionRadius(){return 10;}
 
+static const SPAWNPOINT_Effect_Watch = "IntSpawnWatch";
+static const SPAWNPOINT_Index_Tick = -1;
+
+static spawn_point_batch; // proplist: configuration for the spawn points that CopySpawnPoints() creates
+static spawn_point_keys;  // proplist: registry of the keys that spawn points were configured with, consists of:
+                          // * keys - array: the keys, in order of registration
+                          // * known - proplist: key to true, for the keys in the array
+                          // * counts - proplist: key to the number of spawn points with that key
+                          // * descriptions - proplist: key to description
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // definitions
@@ -85,6 +101,84 @@ global func CopySpawnPoint(object spawn_point, int x, int y, bool mirrored)
 	return point;
 }
 
+/**
+ Uses the settings of an existing spawn point and creates new spawn points with these settings at the given coordinates.
+ This is faster than calling {@link SpawnPoint#CopySpawnPoint} for every spawn point: The spawn points share one
+ configuration, and they set themselves up only when they are needed, usually at round start.
+ The coordinates are relative to object coordinates in local context.
+ @par spawn_point This has to be a spawn point object.
+ @par coordinates An array of coordinates, each entry is an array {@c [x, y]}.
+ @par mirrored If {@c true} the objects will be created at {@c LandscapeWidth() - x} instead of {@c x}.
+ @return array Returns the spawn point objects, in the order of the coordinates.
+  */
+global func CopySpawnPoints(object spawn_point, array coordinates, bool mirrored)
+{
+	if (coordinates == nil)
+	{
+		FatalError("You have to specify an array of coordinates");
+	}
+	else if (spawn_point == nil)
+	{
+		FatalError("spawn_point has to be an existing object");
+	}
+	else if (!(spawn_point->~IsSpawnPoint()))
+	{
+		FatalError("spawn_point has to be return true in IsSpawnPoint()");
+	}
+
+	for (var coordinate in coordinates)
+	{
+		if (!this && (coordinate == nil || coordinate[0] == nil || coordinate[1] == nil))
+		{
+			FatalError("You have to specify x and y values in global context");
+		}
+	}
+
+	var points = CreateArray(GetLength(coordinates));
+	spawn_point_batch = spawn_point->GetTemplateData();
+
+	for (var i = 0; i < GetLength(coordinates); i++)
+	{
+		var x = coordinates[i][0];
+		var y = coordinates[i][1];
+
+		if (mirrored)
+		{
+			x = LandscapeWidth() - x;
+		}
+
+		points[i] = CreateObject(spawn_point->GetID(), x, y, NO_OWNER);
+	}
+
+	spawn_point_batch = nil;
+	return points;
+}
+
+/**
+ Gets the keys that spawn points are configured with. A key is a string that was passed to
+ {@link SpawnPoint#SetID}. Keys that no existing spawn point uses are not listed.
+ The game configuration uses the keys for configuring the spawned items.
+ @return array The keys, in the order in which the spawn points were configured.
+  */
+global func GetSpawnPointKeys()
+{
+	if (spawn_point_keys == nil) return [];
+
+	return spawn_point_keys.keys;
+}
+
+/**
+ Gets the description of a spawn point key.
+ @par key The key.
+ @return string The description that was passed to {@link SpawnPoint#SetDescription}, or {@c nil}.
+  */
+global func GetSpawnPointDescription(string key)
+{
+	if (spawn_point_keys == nil) return nil;
+
+	return GetProperty(key, spawn_point_keys.descriptions);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // finished functions
@@ -96,22 +190,45 @@ local spawn_id_parameter;	// id / string: the parameter that was used for config
 local respawn_if_removed;	// bool: per default the respawn countdown begins if the item is collected
 							//       if this is set to true, then it begins if the item does not exist anymore
 local spawn_description;	// string: describes the spawnpoint type for the configuration menu.
+local spawn_registered_key; // string: the spawn point counts for this key in the registry, see RegisterKey()
                             
 local draw_transformation;  // proplist: deco objects have this transformation
 local is_active;			// bool: is it active? yes or no
 
-local spawn_object;			// array map: player index to spawned object
-local spawn_timer;			// array map: player index to respawn countdown
+local is_spawning;			// bool: is the spawn point registered with the scheduler?
+local spawn_origin;			// int: frame in which the spawn point started spawning
+
+local spawn_slot;			// array map: player number to player slot, see GetPlayerSlot()
+local slot_player;			// array map: player slot to player number, nil if the slot is free
+local free_slots;			// array: player slots that can be reused
+
+local spawn_object;			// array map: player slot to spawned object
+local spawn_timer;			// array map: player slot to respawn countdown
+local spawn_due;			// array map: player slot to the frame in which the object respawns, nil if not scheduled
+local spawn_tick_due;		// int: frame of the next EffectTimer() call, nil if not scheduled
+local is_collecting;		// bool: is the spawn point registered for collection?
 local spawn_globally;		// bool: spawn objects for every player individually?
 							//       true - there is only one object - first come, first serve
 							//       false - every player can collect one object
 local spawn_team;			// int: item can be collected by a team only
-local spawn_visibility;		// array map: player index to spawned object, original visibility
+local spawn_visibility;		// array map: player slot to spawned object, original visibility
 local spawn_collectible;    // bool: object can be collected
+local spawn_pooled;         // bool: objects are parked in the spawn point pool instead of being removed
+local spawn_exact;          // bool: respawn times are exact, instead of being rounded up to SpawnPointEffectInterval()
+local spawn_shared;         // bool: players share one object, see SetShared()
+local shared_object;        // object: the shared object
+local shared_available;     // array map: player slot to true if the slot can collect the shared object;
+                            //      other slots have collected it and wait for the respawn
 
 local spawn_callback;       // proplist:
                             // * command - string or function: the function to call in the spawned object
                             // * parameters - array: parameters for the function call, in order
+                            // the proplist is shared with copies of the spawn point, so it is replaced instead of changed
+
+local telemetry_stats;      // proplist: counters in the spawn point telemetry, see RecordTelemetry()
+
+local spawn_config;         // proplist: the configuration from CopySpawnPoints(), see GetTemplateData();
+                            // nil if the spawn point is set up already
                             
 /**
  Marks the object as a spawn point.
@@ -120,6 +237,22 @@ public func IsSpawnPoint(){ return true; }
 
 
 public func Construction(object by_object)
+{
+	SubscribeRoundEvents(this);
+
+	// spawn points from CopySpawnPoints() are set up when they are needed
+	if (spawn_point_batch != nil)
+	{
+		spawn_config = spawn_point_batch;
+		RegisterKey();
+		return;
+	}
+
+	SetupSpawnPoint();
+}
+
+
+private func SetupSpawnPoint()
 {
 	timer_interval = SPAWNPOINT_Timer_Default;
 	spawn_id = nil;
@@ -127,21 +260,38 @@ public func Construction(object by_object)
 	respawn_if_removed = false;
 	
 	is_active = false;
+	is_spawning = false;
+	is_collecting = false;
 	draw_transformation = nil;
 	
+	spawn_slot = CreateArray();
+	slot_player = CreateArray();
+	free_slots = CreateArray();
+	
 	spawn_object = CreateArray();
 	spawn_timer = CreateArray();
+	spawn_due = CreateArray();
 	spawn_visibility = CreateArray();
 	spawn_globally = false;
 	
 	spawn_team = nil;
 
 	spawn_collectible = false;
+	spawn_pooled = false;
+	spawn_exact = false;
+	spawn_shared = false;
+	shared_available = [];
 	
 	spawn_callback = {
 		command = nil,
 		parameters = [],
 	};
+	
+	// players that join later get their slot in InitializePlayer()
+	for (var i = 0; i < GetPlayerCount(); i++)
+	{
+		AssignPlayerSlot(GetPlayerByIndex(i));
+	}
 }
 
 
@@ -161,22 +311,78 @@ public func CopyDataFromTemplate(object template)
 	{
 		FatalError("Copying works only with objects of the same ID");
 	}
-	
-	timer_interval = template.timer_interval;
-	spawn_id = template.spawn_id;
-	spawn_id_parameter = template.spawn_id_parameter;
-	respawn_if_removed = template.respawn_if_removed;
-	draw_transformation = template.draw_transformation;
-	is_active = template.is_active;
-	// spawn_object = template.spawn_object;
-	// spawn_timer = template.spawn_timer;
-	spawn_globally = template.spawn_globally;
-	spawn_description = template.spawn_description;
 
-	spawn_team = template.spawn_team;
-	spawn_collectible = template.spawn_collectible;
+	EnsureSetup();
+	ApplyTemplateData(template->GetTemplateData());
+	RegisterKey();
+}
+
+
+/**
+ Gets the configuration of the spawn point, as it is copied by {@link SpawnPoint#CopyDataFromTemplate}.
+ @return proplist The configuration. Do not modify it, because it may be shared by several spawn points.
+  */
+public func GetTemplateData()
+{
+	if (spawn_config != nil)
+	{
+		return spawn_config;
+	}
+
+	return {
+		timer_interval = timer_interval,
+		spawn_id = spawn_id,
+		spawn_id_parameter = spawn_id_parameter,
+		respawn_if_removed = respawn_if_removed,
+		draw_transformation = draw_transformation,
+		is_active = is_active,
+		spawn_globally = spawn_globally,
+		spawn_description = spawn_description,
+		spawn_team = spawn_team,
+		spawn_collectible = spawn_collectible,
+		spawn_pooled = spawn_pooled,
+		spawn_exact = spawn_exact,
+		spawn_shared = spawn_shared,
+		spawn_callback = spawn_callback,
+	};
+}
+
+
+private func ApplyTemplateData(proplist config)
+{
+	timer_interval = config.timer_interval;
+	spawn_id = config.spawn_id;
+	spawn_id_parameter = config.spawn_id_parameter;
+	respawn_if_removed = config.respawn_if_removed;
+	draw_transformation = config.draw_transformation;
+	is_active = config.is_active;
+	spawn_globally = config.spawn_globally;
+	spawn_description = config.spawn_description;
+
+	spawn_team = config.spawn_team;
+	spawn_collectible = config.spawn_collectible;
+	spawn_pooled = config.spawn_pooled;
+	spawn_exact = config.spawn_exact;
+	spawn_shared = config.spawn_shared;
 	
-	spawn_callback = { Prototype = template.spawn_callback };
+	spawn_callback = config.spawn_callback;
+}
+
+
+/**
+ Sets up a spawn point that was created by {@link SpawnPoint#CopySpawnPoints}.
+ Does nothing if the spawn point is set up already.
+  */
+private func EnsureSetup()
+{
+	if (spawn_config != nil)
+	{
+		var config = spawn_config;
+		spawn_config = nil;
+
+		SetupSpawnPoint();
+		ApplyTemplateData(config);
+	}
 }
 
 
@@ -185,6 +391,8 @@ public func CopyDataFromTemplate(object template)
  - enables the spawn point@br
  - does not react to collection@br
  - object spawns globally@br
+ @note Decoration that spawns only once per round, with {@c SPAWNPOINT_Timer_Infinite}, does not need a spawn point.
+       {@link Arena_SpawnPointDeco#AddDecoSpawn} is cheaper for that.
  @par definition See {@link SpawnPoint#SetID}.
  @par transformation See {@link SpawnPoint#SetTransformation}.
  @return object Returns the spawn point object, so that further function calls can be issued.
@@ -232,6 +440,21 @@ public func SpawnItem(definition, proplist transformation, bool spawn_global)
   */
 public func SetActive(bool active)
 {
+	EnsureSetup();
+
+	// the respawn countdown does not continue while the spawn point is inactive
+	if (IsSpawning() && active != is_active)
+	{
+		if (active)
+		{
+			ScheduleSpawns();
+		}
+		else
+		{
+			SuspendSpawns();
+		}
+	}
+
 	is_active = active;
 	return this;
 }
@@ -269,10 +492,11 @@ public func SetID(definition)
 	if (GetType(definition) == C4V_Def)
 	{
 			spawn_id = definition;
+			RegisterKey();
 	}
 	else if (GetType(definition) == C4V_String)
 	{
-		// TODO: update docu :)
+		RegisterKey();
 	}
 	else
 	{
@@ -308,6 +532,8 @@ public func SetGlobal(bool spawn_global)
   */
 public func SetRespawnTimer(int timer)
 {
+	EnsureSetup();
+
 	if (timer < SPAWNPOINT_Timer_Infinite)
 	{
 		FatalError(Format("Use values >= %d", SPAWNPOINT_Timer_Infinite));
@@ -329,6 +555,8 @@ public func SetRespawnTimer(int timer)
 // TODO: specify data format, update docu
 public func SetTransformation(proplist transformation)
 {
+	EnsureSetup();
+
 	draw_transformation = transformation;
 	return this;
 }
@@ -355,6 +583,63 @@ public func SetDescription(string description)
 	}
 
 	spawn_description = description;
+	RegisterKey();
+	return this;
+}
+
+
+/**
+ Configures, whether the spawned objects are reused. If enabled, objects that are reclaimed at
+ the end of a round are parked in the {@link Arena_SpawnPointPool#index spawn point pool}
+ instead of being removed, and spawning takes an object from the pool if there is one.
+ @note The objects get the callback {@c ResetForSpawnPoint()} when they are parked,
+       so that they can restore their original state.
+ @par pooled {@c true} enables reuse,@br
+             {@c false} disables reuse. This is the default option of the spawn point.
+ @return object Returns the spawn point object, so that further function calls can be issued.
+  */
+public func SetPooled(bool pooled)
+{
+	ProhibitedWhileSpawning();
+
+	spawn_pooled = pooled;
+	return this;
+}
+
+
+/**
+ Configures, whether objects respawn exactly after the respawn timer ran out.
+ By default, the respawn happens on a time grid of {@c SpawnPointEffectInterval()} frames,
+ so that the respawn time is rounded up to a multiple of that interval.
+ @note With {@c SPAWNPOINT_Timer_Infinite} the object spawns once in the frame after the round start.
+ @par exact {@c true} the object respawns exactly {@link SpawnPoint#SetRespawnTimer timer} frames after it was collected,@br
+            {@c false} the respawn time is rounded up to the time grid. This is the default option of the spawn point.
+ @return object Returns the spawn point object, so that further function calls can be issued.
+  */
+public func SetExactTimer(bool exact)
+{
+	ProhibitedWhileSpawning();
+
+	spawn_exact = exact;
+	return this;
+}
+
+
+/**
+ Configures, whether players share one object if the spawn point spawns objects for every player.
+ There is only one object then, instead of one object with a graphics overlay for every player.
+ The object is visible to the players that can collect it, and a player who collects it gets a copy.
+ The player has to wait for the respawn then, while the other players can still collect the object.
+ @note A copy that was collected is not tracked by the spawn point, so {@c respawn_if_removed} has no effect.
+ @par shared {@c true} enables the shared object,@br
+             {@c false} disables it. This is the default option of the spawn point.
+ @return object Returns the spawn point object, so that further function calls can be issued.
+  */
+public func SetShared(bool shared)
+{
+	ProhibitedWhileSpawning();
+
+	spawn_shared = shared;
 	return this;
 }
 
@@ -388,21 +673,111 @@ public func SetCallbackOnSpawn(command, par0, par1, par2, par3, par4, par5, par6
 {
 	ProhibitedWhileSpawning();
 
-	spawn_callback.command = command;
-	
-	spawn_callback.parameters[0] = par0;
-	spawn_callback.parameters[1] = par1;
-	spawn_callback.parameters[2] = par2;
-	spawn_callback.parameters[3] = par3;
-	spawn_callback.parameters[4] = par4;
-	spawn_callback.parameters[5] = par5;
-	spawn_callback.parameters[6] = par6;
-	spawn_callback.parameters[7] = par7;
-	spawn_callback.parameters[8] = par8;
+	spawn_callback = {
+		command = command,
+		parameters = [par0, par1, par2, par3, par4, par5, par6, par7, par8],
+	};
 	return this;
 }
 
 
+/**
+ Adds the key of the spawn point to the registry, see {@link SpawnPoint#GetSpawnPointKeys}.
+ Every spawn point counts for its key, so that the key is removed when no spawn point uses it anymore.
+ Tells the game configuration if the key or its description is new.
+  */
+private func RegisterKey()
+{
+	// lazy copies have their configuration in spawn_config until EnsureSetup()
+	var parameter = spawn_id_parameter;
+	var description = spawn_description;
+	if (spawn_config != nil)
+	{
+		parameter = spawn_config.spawn_id_parameter;
+		description = spawn_config.spawn_description;
+	}
+
+	var key = nil;
+	if (GetType(parameter) == C4V_String)
+	{
+		key = parameter;
+	}
+	
+	// the spawn point was configured with another key before
+	if (spawn_registered_key != nil && spawn_registered_key != key)
+	{
+		UnregisterKey();
+	}
+	
+	if (key == nil) return;
+	
+	if (spawn_point_keys == nil)
+	{
+		spawn_point_keys = {keys = [], known = {}, counts = {}, descriptions = {}};
+	}
+	
+	var changed = false;
+	
+	if (spawn_registered_key == nil)
+	{
+		spawn_registered_key = key;
+		SetProperty(key, GetProperty(key, spawn_point_keys.counts) + 1, spawn_point_keys.counts);
+	}
+	
+	if (!GetProperty(key, spawn_point_keys.known))
+	{
+		SetProperty(key, true, spawn_point_keys.known);
+		PushBack(spawn_point_keys.keys, key);
+		changed = true;
+	}
+	
+	if (description != nil && GetProperty(key, spawn_point_keys.descriptions) != description)
+	{
+		SetProperty(key, description, spawn_point_keys.descriptions);
+		changed = true;
+	}
+	
+	if (!changed) return;
+	
+	var configuration = GameConfiguration();
+	if (configuration)
+	{
+		configuration->~OnSpawnPointRegistered(key);
+	}
+}
+
+
+/**
+ Removes the spawn point from the count of its key. The key is removed from the registry
+ if no other spawn point uses it, and the game configuration is told about that.
+  */
+private func UnregisterKey()
+{
+	var key = spawn_registered_key;
+	if (key == nil || spawn_point_keys == nil) return;
+	
+	spawn_registered_key = nil;
+	
+	var count = GetProperty(key, spawn_point_keys.counts) - 1;
+	if (count > 0)
+	{
+		SetProperty(key, count, spawn_point_keys.counts);
+		return;
+	}
+	
+	SetProperty(key, nil, spawn_point_keys.counts);
+	SetProperty(key, nil, spawn_point_keys.known);
+	SetProperty(key, nil, spawn_point_keys.descriptions);
+	RemoveArrayValue(spawn_point_keys.keys, key, false);
+	
+	var configuration = GameConfiguration();
+	if (configuration)
+	{
+		configuration->~OnSpawnPointUnregistered(key);
+	}
+}
+
+
 /**
  Gets a description of the spawn point type, if it is configurable in the game configuration.
  @related {@link SpawnPoint#SetDescription}
@@ -410,6 +785,7 @@ public func SetCallbackOnSpawn(command, par0, par1, par2, par3, par4, par5, par6
   */
 public func GetDescription()
 {
+	EnsureSetup();
 	return spawn_description;
 }
 
@@ -420,6 +796,7 @@ public func GetDescription()
   */
 public func GetIDParameter()
 {
+	EnsureSetup();
 	return spawn_id_parameter;
 }
 
@@ -430,6 +807,7 @@ public func GetIDParameter()
   */
 public func GetIDSpawned()
 {
+	EnsureSetup();
 	return spawn_id_parameter;
 }
 
@@ -440,6 +818,7 @@ public func GetIDSpawned()
   */
 public func HasCollectibleItem(object clonk)
 {
+	EnsureSetup();
 	return GetCollectibleItemIndex(clonk) > -1;
 }
 
@@ -457,12 +836,21 @@ private func StartSpawning()
 {
 	if (!IsSpawning())
 	{
-		AddEffect(SPAWNPOINT_Effect, this, 1, SpawnPointEffectInterval(), this);
-	}
+		is_spawning = true;
+		spawn_origin = FrameCounter();
+		
+		if (is_active)
+		{
+			ScheduleSpawns();
+		}
 
-	if (spawn_collectible && !GetEffect(SPAWNPOINT_Effect_Collection, this))
-	{
-		AddEffect(SPAWNPOINT_Effect_Collection, this, 1, 1, this);
+		// the scheduler calls EffectTimer() only if it is actually implemented
+		if (GetType(this.EffectTimer) == C4V_Function)
+		{
+			ScheduleTick(GetNextTick());
+		}
+
+		UpdateCollection();
 	}
 }
 
@@ -473,10 +861,17 @@ private func StartSpawning()
   */
 private func StopSpawning()
 {
-	var effect = GetEffect(SPAWNPOINT_Effect, this);
-	if (effect != nil)
+	if (IsSpawning())
 	{
-		RemoveEffect(nil, this, effect);
+		if (is_active)
+		{
+			SuspendSpawns();
+		}
+
+		spawn_tick_due = nil;
+		is_spawning = false;
+		
+		UpdateCollection();
 	}
 
 	var collect = GetEffect(SPAWNPOINT_Effect_Collection, this);
@@ -489,15 +884,17 @@ private func StopSpawning()
 
 private func IsSpawning()
 {
-	return GetEffect(SPAWNPOINT_Effect, this) != nil;
+	return is_spawning;
 }
 
 
 /**
- The internal timer function of the spawn effect.
- This function is called every {@c SpawnPointEffectInterval()} frames. It calls
- {@c EffectTimer(int timer)} in the spawn point. The original implementation has no effect,
- but you can implement this function for custom effects.
+ Compatibility function for the spawn effect, spawn points are driven by the
+ {@link Arena_SpawnPointScheduler#index spawn point scheduler} now.
+ Calls {@c EffectTimer(int timer)} in the spawn point, and spawns the objects
+ that are due. The original implementation of {@c EffectTimer(int timer)} has no effect,
+ but you can implement this function for custom effects. It is called every
+ {@c SpawnPointEffectInterval()} frames while the spawn point is spawning.
   */
 private func FxIntSpawnTimer(object target, proplist effect_nr, int timer)
 {
@@ -524,15 +921,11 @@ private func FxIntSpawnTimer(object target, proplist effect_nr, int timer)
 	
 	this->~EffectTimer(timer);
 	
-	if (spawn_globally)
-	{
-		DecreaseTimer(0);
-	}
-	else
+	for (var index = 0; index < GetLength(spawn_due); index++)
 	{
-		for (var i = 0; i < GetPlayerCount(); i++)
+		if (spawn_due[index] != nil && spawn_due[index] <= FrameCounter())
 		{
-			DecreaseTimer(i);
+			OnSpawnSchedulerCall(index, spawn_due[index]);
 		}
 	}
 	
@@ -540,127 +933,529 @@ private func FxIntSpawnTimer(object target, proplist effect_nr, int timer)
 }
 
 
-private func ProhibitedWhileSpawning()
+/**
+ Callback from the {@link Arena_SpawnPointScheduler#index spawn point scheduler}.
+ @par index The player slot that is due, or {@c SPAWNPOINT_Index_Tick} for {@c EffectTimer()}.
+ @par due The frame that the entry was scheduled for. Outdated entries are ignored.
+  */
+public func OnSpawnSchedulerCall(int index, int due)
 {
-	if (IsSpawning())
+	if (!spawn_point_telemetry)
 	{
-		FatalError("This function should be used for configuring the spawn point - it is not to be called while the spawn point is spawning");
+		ExecuteSchedulerCall(index, due);
+		return;
 	}
+
+	var time = GetTime();
+	ExecuteSchedulerCall(index, due);
+	RecordTelemetry("spawn_calls", 1);
+	RecordTelemetry("spawn_time", GetTime() - time);
 }
 
 
-private func DecreaseTimer(int index)
+private func ExecuteSchedulerCall(int index, int due)
 {
-	if (spawn_object[index] == nil)
-	{		
-		if (spawn_timer[index] <= 0)
-		{
-			DoSpawnObject(index);
-		}
+	if (!IsSpawning()) return;
+
+	if (index == SPAWNPOINT_Index_Tick)
+	{
+		if (due != spawn_tick_due) return;
 		
-		if (timer_interval != SPAWNPOINT_Timer_Infinite)
+		ScheduleTick(due + SpawnPointEffectInterval());
+
+		if (is_active)
 		{
-			spawn_timer[index] -= SpawnPointEffectInterval();
+			this->~EffectTimer(due - spawn_origin);
 		}
-		return true;
+		return;
 	}
-}
-
-
-/**
- Spawns the configured object.
- @note This calls {@c EffectSpawn(int index)} in the spawn point. The original implementation has no effect,
-       but you can implement this function for custom effects.
- @par index The objects are saved in an array, this parameter indicates the position in the array. 
-  */
-private func DoSpawnObject(int index)
-{
-	ResetTimer(index);
 
-	var vis, owner;
+	if (due != spawn_due[index]) return;
 	
-	if (spawn_globally)
-	{
-		vis = VIS_All;
-		owner = NO_OWNER;
-	}
-	else
+	spawn_due[index] = nil;
+
+	if (spawn_id == nil)
 	{
-		vis = VIS_Owner | VIS_God;
-		owner = GetPlayerByIndex(index);
+		FatalError(Format("Spawn point is used without an id that should be spawned. It was configured with '%v' and should spawn '%i'", spawn_id_parameter, spawn_id));
+		return;
 	}
 
-	if (is_active && spawn_id != nil)
+	if (!is_active) return;
+
+	// the player left the game, his slot is not served anymore
+	if (!spawn_globally && slot_player[index] == nil) return;
+
+	if (!HasObject(index))
 	{
-		spawn_object[index] = CreateObject(spawn_id, 0, 0, owner);
-		spawn_visibility[index] = spawn_object[index].Visibility;
-		spawn_object[index].Visibility = vis;
-		
-		if (spawn_collectible)
-		{
-			spawn_object[index]->Enter(this);
-			SetGraphics(nil, nil, GetOverlay(index), GFXOV_MODE_Object, nil, nil, spawn_object[index]);
-		}
-		
-		if (draw_transformation != nil)
+		DoSpawnObject(index);
+
+		// the spawn tick counts towards the countdown on the time grid
+		if (timer_interval != SPAWNPOINT_Timer_Infinite && !spawn_exact)
 		{
-			if (draw_transformation.mesh != nil)
-			{
-				spawn_object[index].MeshTransformation = draw_transformation.mesh;
-			}
-			else
-			{
-				spawn_object[index]->SetObjDrawTransform(draw_transformation.width,
-														 draw_transformation.xskew, 
-														 draw_transformation.xadjust,
-														 draw_transformation.yskew,
-														 draw_transformation.height,
-														 draw_transformation.yadjust,
-														 draw_transformation.overlay_id);
-			}
+			spawn_timer[index] -= SpawnPointEffectInterval();
 		}
 		
-		if (spawn_callback && spawn_callback.command)
+		// nothing was spawned, try again after the countdown
+		if (!HasObject(index))
 		{
-			spawn_object[index]->Call(spawn_callback.command,
-			                          spawn_callback.parameters[0],
-			                          spawn_callback.parameters[1],
-			                          spawn_callback.parameters[2],
-			                          spawn_callback.parameters[3],
-			                          spawn_callback.parameters[4],
-			                          spawn_callback.parameters[5],
-			                          spawn_callback.parameters[6],
-			                          spawn_callback.parameters[7],
-			                          spawn_callback.parameters[8]);
+			ScheduleSpawn(index);
 		}
-		
-		this->~EffectSpawn(index);
 	}
 }
 
 
-/**
- Deletes a spawned object.
- @par index The objects are saved in an array, this parameter indicates the position in the array. 
-  */
-private func RemoveSpawnedObject(int index)
+private func ProhibitedWhileSpawning()
 {
-	if (GetType(spawn_object[index]) == C4V_C4Object)
+	EnsureSetup();
+
+	if (IsSpawning())
 	{
-		 spawn_object[index]->RemoveObject();
+		FatalError("This function should be used for configuring the spawn point - it is not to be called while the spawn point is spawning");
 	}
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// handle collection
 
+/**
+ Schedules the respawn for all player slots that have no object.
+  */
+private func ScheduleSpawns()
+{
+	if (spawn_globally)
+	{
+		ScheduleSpawn(0);
+	}
+	else
+	{
+		for (var slot = 0; slot < GetLength(slot_player); slot++)
+		{
+			if (slot_player[slot] != nil)
+			{
+				ScheduleSpawn(slot);
+			}
+		}
+	}
+}
 
-private func FxIntSpawnCollectTimer(object target, proplist effect_nr, int timer)
+
+/**
+ Schedules the respawn for a player slot, if there is no object and if it is not scheduled already.
+ The object respawns in the tick where the remaining countdown has run out.
+ @par index The objects are saved in an array, this parameter indicates the position in the array, see {@link SpawnPoint#GetPlayerSlot}.
+  */
+private func ScheduleSpawn(int index)
+{
+	if (HasObject(index) || spawn_due[index] != nil) return;
+	
+	if (spawn_exact)
+	{
+		var remaining = 0;
+		if (timer_interval != SPAWNPOINT_Timer_Infinite)
+		{
+			remaining = spawn_timer[index];
+		}
+
+		spawn_due[index] = FrameCounter() + Max(1, remaining);
+		SpawnPointScheduler()->Schedule(this, index, spawn_due[index]);
+		return;
+	}
+
+	var interval = SpawnPointEffectInterval();
+	var ticks = 0;
+	if (timer_interval != SPAWNPOINT_Timer_Infinite && spawn_timer[index] > 0)
+	{
+		ticks = (spawn_timer[index] + interval - 1) / interval;
+	}
+
+	spawn_due[index] = GetNextTick() + ticks * interval;
+	SpawnPointScheduler()->Schedule(this, index, spawn_due[index]);
+}
+
+
+/**
+ Unschedules all respawns. The remaining time is saved in the countdown,
+ so that scheduling them again continues where the countdown stopped.
+  */
+private func SuspendSpawns()
+{
+	// the countdown is measured from the current frame, or from the next tick on the time grid
+	var next_tick = FrameCounter();
+	if (!spawn_exact)
+	{
+		next_tick = GetNextTick();
+	}
+
+	for (var index = 0; index < GetLength(spawn_due); index++)
+	{
+		if (spawn_due[index] != nil)
+		{
+			spawn_timer[index] = Max(0, spawn_due[index] - next_tick);
+			spawn_due[index] = nil;
+		}
+	}
+}
+
+
+private func ScheduleTick(int due)
+{
+	spawn_tick_due = due;
+	SpawnPointScheduler()->Schedule(this, SPAWNPOINT_Index_Tick, due);
+}
+
+
+/**
+ Gets the first frame after the current frame where the spawn point would have ticked
+ with a timer of {@c SpawnPointEffectInterval()} frames.
+  */
+private func GetNextTick()
+{
+	var interval = SpawnPointEffectInterval();
+	return spawn_origin + interval * ((FrameCounter() - spawn_origin) / interval + 1);
+}
+
+
+/**
+ Spawns the configured object.
+ @note This calls {@c EffectSpawn(int index)} in the spawn point. The original implementation has no effect,
+       but you can implement this function for custom effects.
+ @par index The objects are saved in an array, this parameter indicates the position in the array, see {@link SpawnPoint#GetPlayerSlot}.
+  */
+private func DoSpawnObject(int index)
+{
+	ResetTimer(index);
+	
+	if (IsShared())
+	{
+		DoSpawnSharedObject(index);
+		return;
+	}
+
+	var vis, owner;
+	
+	if (spawn_globally)
+	{
+		vis = VIS_All;
+		owner = NO_OWNER;
+	}
+	else
+	{
+		vis = VIS_Owner | VIS_God;
+		owner = slot_player[index];
+	}
+
+	if (is_active && spawn_id != nil)
+	{
+		spawn_object[index] = CreateSpawnedObject(owner);
+		spawn_visibility[index] = spawn_object[index].Visibility;
+		spawn_object[index].Visibility = vis;
+		
+		if (spawn_collectible)
+		{
+			spawn_object[index]->Enter(this);
+			SetGraphics(nil, nil, GetOverlay(index), GFXOV_MODE_Object, nil, nil, spawn_object[index]);
+		}
+		
+		ConfigureSpawnedObject(spawn_object[index]);
+		
+		// notice when the object is removed, so that the respawn can be scheduled
+		AddEffect(SPAWNPOINT_Effect_Watch, spawn_object[index], 1, 0, this, nil, index);
+		
+		UpdateCollection();
+		RecordTelemetry("spawns", 1);
+
+		this->~EffectSpawn(index);
+	}
+}
+
+
+/**
+ Spawns the shared object, or makes it available to a player if it exists already.
+ @par index The player slot, see {@link SpawnPoint#GetPlayerSlot}.
+  */
+private func DoSpawnSharedObject(int index)
+{
+	if (!is_active || spawn_id == nil) return;
+
+	if (shared_object == nil)
+	{
+		shared_object = CreateSpawnedObject(NO_OWNER);
+		shared_object.Visibility = [VIS_Select | VIS_God];
+
+		if (spawn_collectible)
+		{
+			shared_object->Enter(this);
+			SetGraphics(nil, nil, GetOverlay(0), GFXOV_MODE_Object, nil, nil, shared_object);
+		}
+		
+		ConfigureSpawnedObject(shared_object);
+		
+		AddEffect(SPAWNPOINT_Effect_Watch, shared_object, 1, 0, this, nil, nil);
+	}
+	
+	shared_available[index] = true;
+	UpdateSharedVisibility();
+	UpdateCollection();
+	RecordTelemetry("spawns", 1);
+
+	this->~EffectSpawn(index);
+}
+
+
+/**
+ Applies the transformation and the spawn callback to a spawned object.
+ @par item The object.
+  */
+private func ConfigureSpawnedObject(object item)
+{
+	if (draw_transformation != nil)
+	{
+		if (draw_transformation.mesh != nil)
+		{
+			item.MeshTransformation = draw_transformation.mesh;
+		}
+		else
+		{
+			item->SetObjDrawTransform(draw_transformation.width,
+			                          draw_transformation.xskew, 
+			                          draw_transformation.xadjust,
+			                          draw_transformation.yskew,
+			                          draw_transformation.height,
+			                          draw_transformation.yadjust,
+			                          draw_transformation.overlay_id);
+		}
+	}
+	
+	if (spawn_callback && spawn_callback.command)
+	{
+		item->Call(spawn_callback.command,
+		           spawn_callback.parameters[0],
+		           spawn_callback.parameters[1],
+		           spawn_callback.parameters[2],
+		           spawn_callback.parameters[3],
+		           spawn_callback.parameters[4],
+		           spawn_callback.parameters[5],
+		           spawn_callback.parameters[6],
+		           spawn_callback.parameters[7],
+		           spawn_callback.parameters[8]);
+	}
+}
+
+
+/**
+ Shows the shared object to the players that can collect it.
+  */
+private func UpdateSharedVisibility()
+{
+	if (shared_object == nil) return;
+
+	var visibility = [VIS_Select | VIS_God];
+	for (var slot = 0; slot < GetLength(slot_player); slot++)
+	{
+		if (slot_player[slot] != nil && shared_available[slot])
+		{
+			visibility[slot_player[slot] + 1] = true;
+		}
+	}
+	shared_object.Visibility = visibility;
+}
+
+
+/**
+ Does the spawn point have an object for a player slot?
+ @par index The objects are saved in an array, this parameter indicates the position in the array, see {@link SpawnPoint#GetPlayerSlot}.
+  */
+private func HasObject(int index)
 {
-	for (var crew in FindObjects(Find_OCF(OCF_CrewMember), Find_Distance(SpawnPointCollectionRadius())))
+	if (IsShared())
 	{
-		if (TryCollectObject(crew))
+		return shared_object != nil && shared_available[index];
+	}
+	return spawn_object[index] != nil;
+}
+
+
+private func IsShared()
+{
+	return spawn_shared && !spawn_globally;
+}
+
+
+/**
+ Deletes a spawned object.
+ @par index The objects are saved in an array, this parameter indicates the position in the array, see {@link SpawnPoint#GetPlayerSlot}.
+  */
+private func RemoveSpawnedObject(int index)
+{
+	if (GetType(spawn_object[index]) == C4V_C4Object)
+	{
+		if (spawn_pooled)
+		{
+			PoolSpawnedObject(index);
+		}
+		else
+		{
+			spawn_object[index]->RemoveObject();
+		}
+	}
+}
+
+
+/**
+ Creates the object that should be spawned, or takes it from the
+ {@link Arena_SpawnPointPool#index spawn point pool}.
+ @par owner The object belongs to this player.
+ @return object The object.
+  */
+private func CreateSpawnedObject(int owner)
+{
+	if (spawn_pooled)
+	{
+		var item = SpawnPointPool()->Take(spawn_id, owner);
+		if (item)
+		{
+			item->SetPosition(GetX(), GetY());
+			item->SetR(0);
+			item->SetSpeed(0, 0);
+			item->SetRDir(0);
+			return item;
+		}
+	}
+
+	return CreateObject(spawn_id, 0, 0, owner);
+}
+
+
+/**
+ Deletes the shared object.
+  */
+private func RemoveSharedObject()
+{
+	var item = shared_object;
+	
+	shared_object = nil;
+	shared_available = [];
+
+	if (item)
+	{
+		RemoveEffect(SPAWNPOINT_Effect_Watch, item);
+		SetGraphics(nil, nil, GetOverlay(0));
+		
+		if (spawn_pooled)
+		{
+			item.Visibility = VIS_All;
+			SpawnPointPool()->Put(item);
+		}
+		else
+		{
+			item->RemoveObject();
+		}
+	}
+	
+	UpdateCollection();
+}
+
+
+/**
+ Parks a spawned object in the {@link Arena_SpawnPointPool#index spawn point pool}.
+ @par index The objects are saved in an array, this parameter indicates the position in the array, see {@link SpawnPoint#GetPlayerSlot}.
+  */
+private func PoolSpawnedObject(int index)
+{
+	var item = spawn_object[index];
+
+	RemoveEffect(SPAWNPOINT_Effect_Watch, item);
+	spawn_object[index] = nil;
+	
+	item.Visibility = spawn_visibility[index];
+	if (spawn_collectible)
+	{
+		SetGraphics(nil, nil, GetOverlay(index));
+	}
+	
+	SpawnPointPool()->Put(item);
+	UpdateCollection();
+}
+
+private func FxIntSpawnWatchStart(object target, proplist effect, int temp, int index)
+{
+	if (!temp)
+	{
+		effect.index = index;
+	}
+}
+
+
+private func FxIntSpawnWatchStop(object target, proplist effect, int reason, bool temp)
+{
+	if (temp || (reason != FX_Call_RemoveClear && reason != FX_Call_RemoveDeath)) return;
+	
+	// the shared object is about to be removed, all players have to wait for the respawn
+	if (target == shared_object)
+	{
+		shared_object = nil;
+		shared_available = [];
+		
+		if (IsSpawning() && is_active)
+		{
+			ScheduleSpawns();
+		}
+
+		UpdateCollection();
+		return;
+	}
+
+	// the object is about to be removed
+	if (spawn_object[effect.index] == target)
+	{
+		spawn_object[effect.index] = nil;
+		
+		if (IsSpawning() && is_active)
+		{
+			ScheduleSpawn(effect.index);
+		}
+		
+		UpdateCollection();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// handle collection
+
+
+/**
+ Callback from the {@link Arena_SpawnPointScheduler#index spawn point scheduler}, in every frame
+ where crew members are near the spawn point. Crew members within {@c SpawnPointCollectionRadius()}
+ try collecting the item.
+ @par crew The crew members in the grid cells around the spawn point.
+  */
+public func CollectFromCrew(array crew)
+{
+	if (!spawn_point_telemetry)
+	{
+		CollectFromNearbyCrew(crew);
+		return;
+	}
+
+	var time = GetTime();
+	CollectFromNearbyCrew(crew);
+	RecordTelemetry("collect_calls", 1);
+	RecordTelemetry("collect_time", GetTime() - time);
+}
+
+
+private func CollectFromNearbyCrew(array crew)
+{
+	var radius = SpawnPointCollectionRadius();
+	
+	for (var clonk in crew)
+	{
+		if (!clonk) continue;
+
+		var dx = clonk->GetX() - GetX();
+		var dy = clonk->GetY() - GetY();
+		if (dx * dx + dy * dy > radius * radius) continue;
+
+		if (TryCollectObject(clonk))
 		{
 			break;
 		}
@@ -668,6 +1463,56 @@ private func FxIntSpawnCollectTimer(object target, proplist effect_nr, int timer
 }
 
 
+/**
+ Registers the spawn point for collection with the {@link Arena_SpawnPointScheduler#index spawn point scheduler}
+ as long as it is spawning and has an item, and unregisters it otherwise. A spawn point without
+ items costs nothing while it waits for the respawn.
+  */
+private func UpdateCollection()
+{
+	var collecting = IsSpawning() && spawn_collectible && HasSpawnedObject();
+	
+	if (collecting == is_collecting) return;
+	
+	is_collecting = collecting;
+	
+	if (collecting)
+	{
+		SpawnPointScheduler()->RegisterCollection(this);
+	}
+	else if (spawn_point_scheduler)
+	{
+		spawn_point_scheduler->UnregisterCollection(this);
+	}
+}
+
+
+private func HasSpawnedObject()
+{
+	if (IsShared())
+	{
+		return shared_object != nil && IsValueInArray(shared_available, true);
+	}
+
+	for (var item in spawn_object)
+	{
+		if (item != nil) return true;
+	}
+	return false;
+}
+
+
+/**
+ Compatibility function for the collection effect, collection is handled by the
+ {@link Arena_SpawnPointScheduler#index spawn point scheduler} now.
+ Searches for crew members near the spawn point on its own.
+  */
+private func FxIntSpawnCollectTimer(object target, proplist effect_nr, int timer)
+{
+	CollectFromCrew(FindObjects(Find_OCF(OCF_CrewMember), Find_Distance(SpawnPointCollectionRadius())));
+}
+
+
 private func TryCollectObject(object clonk)
 {
 	if (!clonk)
@@ -715,13 +1560,18 @@ private func GetCollectibleItemIndex(object clonk)
 	}
 	else
 	{
-		return GetPlayerIndex(clonk->GetOwner());
+		return GetPlayerSlot(clonk->GetOwner()) ?? -1;
 	}
 }
 
 
 private func DoCollectObject(int index, object clonk)
 {
+	if (IsShared())
+	{
+		return DoCollectSharedObject(index, clonk);
+	}
+
 	var item = spawn_object[index];
 
 	if (!item)
@@ -731,7 +1581,11 @@ private func DoCollectObject(int index, object clonk)
 
 	item.Visibility = spawn_visibility[index] ?? VIS_All; // Make item visible!
 	
-	if (!item->~RejectCollectionFromSpawnPoint(this, clonk))
+	if (item->~RejectCollectionFromSpawnPoint(this, clonk))
+	{
+		RecordTelemetry("rejected", 1);
+	}
+	else
 	{
 		clonk->Collect(item);
 	}
@@ -740,15 +1594,25 @@ private func DoCollectObject(int index, object clonk)
 	{
 		// collecting did not work
 		// item->RemoveObject();
+		RecordTelemetry("failed", 1);
 		return false;
 	}
 	else
 	{
+		RecordTelemetry("collections", 1);
 		this->~EffectCollect(item, clonk);
 		
 		if (!respawn_if_removed)
 		{
 			spawn_object[index] = nil;
+			if (item) RemoveEffect(SPAWNPOINT_Effect_Watch, item);
+			
+			if (IsSpawning() && is_active)
+			{
+				ScheduleSpawn(index);
+			}
+			
+			UpdateCollection();
 		}
 
 		SetGraphics(nil, this->GetID(), GetOverlay(index), GFXOV_MODE_Base);
@@ -757,12 +1621,91 @@ private func DoCollectObject(int index, object clonk)
 }
 
 
+/**
+ Gives a copy of the shared object to a clonk.
+ @par index The player slot, see {@link SpawnPoint#GetPlayerSlot}.
+ @par clonk The clonk that collects the object.
+ @return bool {@c true} if the clonk collected the object.
+  */
+private func DoCollectSharedObject(int index, object clonk)
+{
+	if (!HasObject(index))
+	{
+		return false;
+	}
+	
+	if (shared_object->~RejectCollectionFromSpawnPoint(this, clonk))
+	{
+		RecordTelemetry("rejected", 1);
+		RecordTelemetry("failed", 1);
+		return false;
+	}
+	
+	var item = CreateSpawnedObject(clonk->GetOwner());
+	ConfigureSpawnedObject(item);
+	clonk->Collect(item);
+	
+	if (item && item->Contained() != clonk)
+	{
+		// collecting did not work
+		item->RemoveObject();
+		RecordTelemetry("failed", 1);
+		return false;
+	}
+
+	RecordTelemetry("collections", 1);
+	this->~EffectCollect(item, clonk);
+
+	shared_available[index] = nil;
+	UpdateSharedVisibility();
+	
+	if (IsSpawning() && is_active)
+	{
+		ScheduleSpawn(index);
+	}
+	
+	UpdateCollection();
+	return true;
+}
+
+
 private func EffectCollect(object item, object clonk)
 {
 	clonk->Sound("Clonk::Action::Grab", 0, 0, clonk->GetOwner());
 }
 
 
+/**
+ Increases a counter in the {@link Arena_SpawnPointTelemetry#index spawn point telemetry}.
+ Does nothing if the telemetry does not exist.
+ @par counter The name of the counter.
+ @par amount The counter is increased by this value.
+  */
+private func RecordTelemetry(string counter, int amount)
+{
+	if (!spawn_point_telemetry) return;
+
+	if (telemetry_stats == nil || telemetry_stats.telemetry != spawn_point_telemetry)
+	{
+		telemetry_stats = spawn_point_telemetry->AddPoint(this);
+	}
+	
+	telemetry_stats[counter] += amount;
+}
+
+
+/**
+ Gets the statistics of the spawn point, see {@link Arena_SpawnPointTelemetry#GetPointStatistics}.
+ @return proplist The counters, or {@c nil} if the telemetry does not exist.
+  */
+public func GetTelemetry()
+{
+	if (!spawn_point_telemetry) return nil;
+
+	return spawn_point_telemetry->GetPointStatistics(this);
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Callbacks from game configuration and round managers
@@ -770,6 +1713,8 @@ private func EffectCollect(object item, object clonk)
 
 public func OnConfigurationEnd(object configuration)
 {
+	EnsureSetup();
+
 	if (GetType(spawn_id_parameter) == C4V_String && configuration != nil)
 	{
 		spawn_id = configuration->GetSpawnPointItem(spawn_id_parameter);
@@ -784,8 +1729,39 @@ public func OnConfigurationEnd(object configuration)
 }
 
 
+public func InitializePlayer(int player)
+{
+	// the slot is assigned when the spawn point is set up
+	if (spawn_config != nil) return;
+
+	var slot = AssignPlayerSlot(player);
+
+	// the new player gets his own object, as soon as possible
+	if (IsSpawning() && is_active && !spawn_globally)
+	{
+		ScheduleSpawn(slot);
+	}
+}
+
+
+public func RemovePlayer(int player)
+{
+	if (spawn_config != nil) return;
+
+	ReleasePlayerSlot(player);
+}
+
+
+public func Destruction()
+{
+	StopSpawning();
+	UnregisterKey();
+}
+
+
 public func OnRoundStart()
 {
+	EnsureSetup();
 	RemoveSpawnedObjects();
 	StartSpawning();
 }
@@ -793,6 +1769,9 @@ public func OnRoundStart()
 
 public func OnRoundEnd()
 {
+	// nothing spawned yet
+	if (spawn_config != nil) return;
+
 	StopSpawning();
 	RemoveSpawnedObjects();
 }
@@ -800,20 +1779,98 @@ public func OnRoundEnd()
 
 private func RemoveSpawnedObjects()
 {
-	if (spawn_globally)
+	if (IsShared())
+	{
+		RemoveSharedObject();
+	}
+	else if (spawn_globally)
 	{
 		RemoveSpawnedObject(0);
 	}
 	else
 	{
-		for(var i=0; i < GetPlayerCount(); i++)
+		for (var slot = 0; slot < GetLength(slot_player); slot++)
 		{
-			RemoveSpawnedObject(i);
+			RemoveSpawnedObject(slot);
 		}
 	}
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Player slots
+
+
+/**
+ Gets the slot of a player. The objects for a player are saved in arrays, this
+ is the position in these arrays. Unlike the player index, the slot of a player does not
+ change while he is in the game. Slots of players that left the game are reused.
+ @par player The player number.
+ @return int The slot, or {@c nil} if the player has no slot.
+  */
+public func GetPlayerSlot(int player)
+{
+	EnsureSetup();
+
+	if (player < 0) return nil;
+
+	return spawn_slot[player];
+}
+
+
+private func AssignPlayerSlot(int player)
+{
+	if (player < 0) return nil;
+
+	var slot = spawn_slot[player];
+	if (slot != nil) return slot;
+
+	if (GetLength(free_slots) > 0)
+	{
+		slot = PopBack(free_slots);
+	}
+	else
+	{
+		slot = GetLength(slot_player);
+	}
+
+	spawn_slot[player] = slot;
+	slot_player[slot] = player;
+	spawn_timer[slot] = nil;
+	spawn_due[slot] = nil;
+	shared_available[slot] = nil;
+	return slot;
+}
+
+
+private func ReleasePlayerSlot(int player)
+{
+	var slot = GetPlayerSlot(player);
+	if (slot == nil) return;
+
+	if (IsShared())
+	{
+		spawn_due[slot] = nil;
+		shared_available[slot] = nil;
+		UpdateSharedVisibility();
+		UpdateCollection();
+	}
+	else if (!spawn_globally)
+	{
+		RemoveSpawnedObject(slot);
+		spawn_object[slot] = nil;
+		spawn_due[slot] = nil;
+		SetGraphics(nil, nil, GetOverlay(slot));
+		UpdateCollection();
+	}
+
+	spawn_slot[player] = nil;
+	slot_player[slot] = nil;
+	PushBack(free_slots, slot);
+}
+
+
 private func GetOverlay(int index)
 {
 	return GFX_Overlay + index;
@@ -0,0 +1,290 @@
+/**
+ Spawns decoration objects at round start, without a {@link SpawnPoint#index spawn point} object for each of them.@br
+ A spawn point that is configured with {@link SpawnPoint#SpawnDeco} and {@c SPAWNPOINT_Timer_Infinite}
+ only creates its object once per round, but it is a full object nonetheless. For maps with a lot of
+ decoration it is cheaper to register the decoration here: The registry keeps one record per object
+ and creates all objects when the round starts. The objects are removed when the round ends.@br
+ @br
+ The timing is the same as with such spawn points: The objects are created on the first tick of the
+ {@c SpawnPointEffectInterval()} time grid after the round start, and an object that is removed during
+ the round, for example grass that burnt, is created again on the next tick.
+ @title Deco Spawn Registry
+ @id index
+ @author Marky
+*/
+
+static const SPAWNPOINT_Effect_DecoWatch = "IntDecoWatch";
+
+static spawn_point_deco; // object: the one and only registry, see SpawnPointDeco()
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// definitions
+
+local Name = "Spawnpoint Deco";
+
+local deco_records;  // array: one record per object, a record consists of:
+                     // * x - int: the x coordinate
+                     // * y - int: the y coordinate
+                     // * id - id: the object is of this type
+                     // * transformation - proplist: the object has this transformation, see SpawnPoint::SetTransformation()
+local deco_objects;  // array map: record index to the object that was spawned in the current round
+local deco_missing;  // array: the indices of the records that have no object
+local deco_origin;   // int: the frame where the round started, the time grid starts here
+local deco_due;      // int: the frame where the missing objects are created, or nil if nothing is scheduled
+local is_spawning;   // bool: the round is running
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// global functions
+
+/**
+ Gets the deco spawn registry. The registry is created if it does not exist yet.
+ @return object The {@link Arena_SpawnPointDeco#index registry} object.
+  */
+global func SpawnPointDeco()
+{
+	if (!spawn_point_deco)
+	{
+		spawn_point_deco = CreateObject(Arena_SpawnPointDeco, 0, 0, NO_OWNER);
+	}
+	return spawn_point_deco;
+}
+
+
+/**
+ Registers a decoration object that is spawned at the start of every round.
+ This behaves like a spawn point with {@link SpawnPoint#SpawnDeco} and {@c SPAWNPOINT_Timer_Infinite}:
+ The object spawns on the first tick after the round start, and again if it was removed.
+ The coordinates are relative to object coordinates in local context.
+ @par x The x coordinate.
+ @par y The y coordinate.
+ @par definition The object is of this type.
+ @par transformation See {@link SpawnPoint#SetTransformation}.
+  */
+global func AddDecoSpawn(int x, int y, id definition, proplist transformation)
+{
+	if (!this && (x == nil || y == nil))
+	{
+		FatalError("You have to specify x and y values in global context");
+	}
+	
+	if (this)
+	{
+		x += GetX();
+		y += GetY();
+	}
+	
+	SpawnPointDeco()->AddRecord(x, y, definition, transformation);
+}
+
+
+/**
+ Registers decoration objects of the same type at several coordinates, see {@link Arena_SpawnPointDeco#AddDecoSpawn}.
+ The coordinates are relative to object coordinates in local context.
+ @par definition The objects are of this type.
+ @par coordinates An array of coordinates, each entry is an array {@c [x, y]}.
+ @par mirrored If {@c true} the objects will be created at {@c LandscapeWidth() - x} instead of {@c x}.
+ @par transformation See {@link SpawnPoint#SetTransformation}.
+  */
+global func AddDecoSpawns(id definition, array coordinates, bool mirrored, proplist transformation)
+{
+	if (coordinates == nil)
+	{
+		FatalError("You have to specify an array of coordinates");
+	}
+	
+	for (var coordinate in coordinates)
+	{
+		var x = coordinate[0];
+		
+		if (mirrored && x != nil)
+		{
+			x = LandscapeWidth() - x;
+		}
+
+		AddDecoSpawn(x, coordinate[1], definition, transformation);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// finished functions
+
+protected func Initialize()
+{
+	deco_records = [];
+	deco_objects = [];
+	deco_missing = [];
+	
+	SubscribeRoundEvents(this);
+}
+
+// Disabled, the records are created by the scenario script
+public func SaveScenarioObject() { return false; }
+
+
+/**
+ Adds a record to the registry. You should use {@link Arena_SpawnPointDeco#AddDecoSpawn} instead.
+ @par x The x coordinate, in global coordinates.
+ @par y The y coordinate, in global coordinates.
+ @par definition The object is of this type.
+ @par transformation See {@link SpawnPoint#SetTransformation}.
+  */
+public func AddRecord(int x, int y, id definition, proplist transformation)
+{
+	if (definition == nil)
+	{
+		FatalError("You have to specify a definition");
+	}
+
+	PushBack(deco_records, {x = x, y = y, id = definition, transformation = transformation});
+
+	// records that are added during the round spawn like the others
+	if (is_spawning)
+	{
+		PushBack(deco_missing, GetLength(deco_records) - 1);
+		ScheduleSpawns();
+	}
+}
+
+
+/**
+ Gets the number of registered decoration objects.
+ @return int The number of records.
+  */
+public func GetRecordCount()
+{
+	return GetLength(deco_records);
+}
+
+
+public func OnRoundStart()
+{
+	RemoveDecoObjects();
+	
+	is_spawning = true;
+	deco_origin = FrameCounter();
+	
+	for (var index = 0; index < GetLength(deco_records); index++)
+	{
+		PushBack(deco_missing, index);
+	}
+	
+	ScheduleSpawns();
+}
+
+
+public func OnRoundEnd()
+{
+	RemoveDecoObjects();
+}
+
+
+/**
+ Callback from the {@link Arena_SpawnPointScheduler#index spawn point scheduler}.
+ Creates the objects that are missing.
+ @par index Not used.
+ @par due The frame that the entry was scheduled for. Outdated entries are ignored.
+  */
+public func OnSpawnSchedulerCall(int index, int due)
+{
+	if (!is_spawning || due != deco_due) return;
+	
+	deco_due = nil;
+	
+	var missing = deco_missing;
+	deco_missing = [];
+	
+	for (var record_index in missing)
+	{
+		var record = deco_records[record_index];
+		var deco = CreateObject(record.id, record.x - GetX(), record.y - GetY(), NO_OWNER);
+		if (deco)
+		{
+			ApplyTransformation(deco, record.transformation);
+			deco_objects[record_index] = deco;
+			
+			// notice when the object is removed, so that it can be created again
+			AddEffect(SPAWNPOINT_Effect_DecoWatch, deco, 1, 0, this, nil, record_index);
+		}
+		else
+		{
+			// nothing was spawned, try again on the next tick
+			PushBack(deco_missing, record_index);
+		}
+	}
+	
+	ScheduleSpawns();
+}
+
+
+private func ScheduleSpawns()
+{
+	if (deco_due != nil || GetLength(deco_missing) == 0) return;
+	
+	// the first frame after the current frame on the time grid of the spawn points
+	var interval = SpawnPoint->SpawnPointEffectInterval();
+	deco_due = deco_origin + interval * ((FrameCounter() - deco_origin) / interval + 1);
+	
+	SpawnPointScheduler()->Schedule(this, 0, deco_due);
+}
+
+
+private func RemoveDecoObjects()
+{
+	// the watch effects must not create the objects again
+	is_spawning = false;
+	deco_due = nil;
+	deco_missing = [];
+	
+	for (var deco in deco_objects)
+	{
+		if (deco) deco->RemoveObject();
+	}
+	deco_objects = [];
+}
+
+
+private func FxIntDecoWatchStart(object target, proplist effect, int temp, int index)
+{
+	if (!temp)
+	{
+		effect.index = index;
+	}
+}
+
+
+private func FxIntDecoWatchStop(object target, proplist effect, int reason, bool temp)
+{
+	if (temp || (reason != FX_Call_RemoveClear && reason != FX_Call_RemoveDeath)) return;
+	
+	// the object is about to be removed
+	if (is_spawning && deco_objects[effect.index] == target)
+	{
+		deco_objects[effect.index] = nil;
+		PushBack(deco_missing, effect.index);
+		ScheduleSpawns();
+	}
+}
+
+
+private func ApplyTransformation(object deco, proplist transformation)
+{
+	if (transformation == nil) return;
+
+	if (transformation.mesh != nil)
+	{
+		deco.MeshTransformation = transformation.mesh;
+	}
+	else
+	{
+		deco->SetObjDrawTransform(transformation.width,
+		                          transformation.xskew, 
+		                          transformation.xadjust,
+		                          transformation.yskew,
+		                          transformation.height,
+		                          transformation.yadjust,
+		                          transformation.overlay_id);
+	}
+}
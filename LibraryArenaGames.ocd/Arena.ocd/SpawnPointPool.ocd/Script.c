@@ -0,0 +1,156 @@
+/**
+ Keeps objects from {@link SpawnPoint#index spawn points} for reuse.@br
+ Spawn points that are configured with {@link SpawnPoint#SetPooled} do not remove
+ their objects at the end of a round. Instead, the objects are reset and parked
+ in this object, and the next spawn of the same type takes an object from here
+ instead of creating a new one.@br
+ @br
+ Objects that are parked get the callback {@c ResetForSpawnPoint()}, so that
+ they can restore their original state, for example ammunition or effects.
+ @title Spawn Point Pool
+ @id index
+ @author Marky
+*/
+
+static spawn_point_pool; // object: the one and only pool, see SpawnPointPool()
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// definitions
+
+local Name = "Spawnpoint Pool";
+
+local pooled_objects; // proplist: definition, as string, to array of parked objects
+local reused_count;   // int: how often an object was taken from the pool
+local parked_count;   // int: how often an object was parked in the pool
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// global functions
+
+/**
+ Gets the spawn point pool. The pool is created if it does not exist yet.
+ @return object The {@link Arena_SpawnPointPool#index pool} object.
+  */
+global func SpawnPointPool()
+{
+	if (!spawn_point_pool)
+	{
+		spawn_point_pool = CreateObject(Arena_SpawnPointPool, 0, 0, NO_OWNER);
+	}
+	return spawn_point_pool;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// finished functions
+
+protected func Initialize()
+{
+	pooled_objects = {};
+	reused_count = 0;
+	parked_count = 0;
+}
+
+// Disabled, parked objects are not part of the scenario
+public func SaveScenarioObject() { return false; }
+
+
+/**
+ Parks an object in the pool. Calls {@c ResetForSpawnPoint()} in the object first.
+ @par item The object.
+ @return bool {@c true} if the object was parked. If the object cannot enter the pool,
+         then it is removed.
+  */
+public func Put(object item)
+{
+	if (!item) return false;
+
+	item->~ResetForSpawnPoint();
+	
+	// the callback may have removed the object
+	if (!item) return false;
+
+	item->SetOwner(NO_OWNER);
+	item->Enter(this);
+
+	if (item->Contained() != this)
+	{
+		item->RemoveObject();
+		return false;
+	}
+
+	var key = Format("%i", item->GetID());
+	var items = GetProperty(key, pooled_objects);
+	if (items == nil)
+	{
+		items = [];
+		SetProperty(key, items, pooled_objects);
+	}
+	
+	PushBack(items, item);
+	parked_count++;
+	return true;
+}
+
+
+/**
+ Takes an object from the pool.
+ @par definition The object should be of this type.
+ @par owner The object is given to this player.
+ @return object An object that was parked in the pool, or {@c nil} if there is none.
+  */
+public func Take(id definition, int owner)
+{
+	var items = GetProperty(Format("%i", definition), pooled_objects);
+	
+	while (items != nil && GetLength(items) > 0)
+	{
+		var item = PopBack(items);
+
+		// parked objects may have been removed in the meantime
+		if (item)
+		{
+			item->Exit();
+			item->SetOwner(owner);
+			reused_count++;
+			return item;
+		}
+	}
+	
+	return nil;
+}
+
+
+/**
+ Gets the number of parked objects of a type.
+ @par definition The type.
+ @return int The number of objects.
+  */
+public func GetPooledCount(id definition)
+{
+	var items = GetProperty(Format("%i", definition), pooled_objects);
+	if (items == nil) return 0;
+	
+	return GetLength(items);
+}
+
+
+/**
+ Gets how often an object was taken from the pool instead of being created.
+ @return int The number of reused objects.
+  */
+public func GetReusedCount()
+{
+	return reused_count;
+}
+
+
+/**
+ Gets how often an object was parked in the pool instead of being removed.
+ @return int The number of parked objects.
+  */
+public func GetParkedCount()
+{
+	return parked_count;
+}
@@ -0,0 +1,355 @@
+/**
+ Drives all {@link SpawnPoint#index spawn points} from a single timer.@br
+ Spawn points do not poll on their own. Instead, they tell the scheduler in which frame
+ something is due, for example the respawn of an item for a player, and the scheduler
+ calls them back in exactly that frame. Entries are kept in a min-heap that is ordered
+ by frame, so the timer only looks at the first entry as long as nothing is due.@br
+ @br
+ The scheduler also handles collection from spawn points: Crew members are sorted into a
+ uniform grid once per frame, and a spawn point is checked only if there are crew members
+ in the cells around it.
+ @title Spawn Point Scheduler
+ @id index
+ @author Marky
+*/
+
+static const SPAWNPOINT_Scheduler_Effect = "IntSpawnScheduler";
+static const SPAWNPOINT_Grid_CellSize = 32;
+
+static spawn_point_scheduler; // object: the one and only scheduler, see SpawnPointScheduler()
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// definitions
+
+local Name = "Spawnpoint Scheduler";
+
+local schedule_heap;  // array: min-heap of scheduled entries, ordered by frame; an entry consists of:
+                      // * due - int: the frame in which the entry is due
+                      // * point - object: this object gets the callback
+                      // * index - int: passed to the callback, identifies what is due
+                      // * order - int: entries that are due in the same frame are executed in the order they were added
+local schedule_order; // int: counts the added entries
+
+local grid_columns;      // int: number of cells in x direction
+local grid_rows;         // int: number of cells in y direction
+local collection_points; // array map: cell to the spawn points in that cell that react to collection
+local collection_count;  // int: number of spawn points that react to collection
+local collection_reach;  // int: spawn points look for crew members in this many cells around their own cell
+local crew_grid;         // array map: cell to the crew members in that cell, updated every frame
+local crew_cells;        // array: the cells that contain crew members
+local cell_checked;      // array map: cell to the last frame where the spawn points in that cell were checked
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// global functions
+
+/**
+ Gets the spawn point scheduler. The scheduler is created if it does not exist yet.
+ @return object The {@link Arena_SpawnPointScheduler#index scheduler} object.
+  */
+global func SpawnPointScheduler()
+{
+	if (!spawn_point_scheduler)
+	{
+		spawn_point_scheduler = CreateObject(Arena_SpawnPointScheduler, 0, 0, NO_OWNER);
+	}
+	return spawn_point_scheduler;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// finished functions
+
+protected func Initialize()
+{
+	schedule_heap = [];
+	schedule_order = 0;
+	
+	grid_columns = LandscapeWidth() / SPAWNPOINT_Grid_CellSize + 1;
+	grid_rows = LandscapeHeight() / SPAWNPOINT_Grid_CellSize + 1;
+	collection_points = [];
+	collection_count = 0;
+	collection_reach = 1;
+	crew_grid = [];
+	crew_cells = [];
+	cell_checked = [];
+
+	AddEffect(SPAWNPOINT_Scheduler_Effect, this, 1, 1, this);
+}
+
+// Disabled, the spawn points register again when they start spawning
+public func SaveScenarioObject() { return false; }
+
+
+/**
+ Schedules a callback {@c OnSpawnSchedulerCall(int index, int due)} in an object.
+ @note Entries cannot be removed. The object should simply ignore callbacks
+       that are outdated, see the {@c due} parameter.
+ @par point The callback is issued in this object, usually a spawn point.
+ @par index This value is passed to the callback.
+ @par due The callback is issued in this frame. Entries in the past are
+          issued in the next frame.
+  */
+public func Schedule(object point, int index, int due)
+{
+	if (point == nil)
+	{
+		FatalError("Must specify an existing object");
+	}
+
+	HeapPush({due = due, point = point, index = index, order = schedule_order++});
+}
+
+
+/**
+ Issues all callbacks that are due until the given frame.
+ @par frame Entries with a frame up to and including this value are executed.
+  */
+public func ExecuteDue(int frame)
+{
+	while (GetLength(schedule_heap) > 0 && schedule_heap[0].due <= frame)
+	{
+		var entry = HeapPop();
+
+		if (entry.point)
+		{
+			entry.point->~OnSpawnSchedulerCall(entry.index, entry.due);
+		}
+	}
+}
+
+
+/**
+ Gets the number of scheduled entries, including outdated ones.
+ @return int The number of entries.
+  */
+public func GetScheduledCount()
+{
+	return GetLength(schedule_heap);
+}
+
+
+/**
+ Registers a spawn point for collection. The spawn point gets the callback
+ {@c CollectFromCrew(array crew)} in every frame where crew members are nearby.
+ @par point The spawn point. Spawn points do not move, so the position at the time of
+            registration is used.
+  */
+public func RegisterCollection(object point)
+{
+	var cell = GetCell(point->GetX(), point->GetY());
+	
+	if (collection_points[cell] == nil)
+	{
+		collection_points[cell] = [];
+	}
+	else if (IsValueInArray(collection_points[cell], point))
+	{
+		return;
+	}
+
+	PushBack(collection_points[cell], point);
+	collection_count++;
+
+	var radius = point->SpawnPointCollectionRadius();
+	collection_reach = Max(collection_reach, (radius + SPAWNPOINT_Grid_CellSize - 1) / SPAWNPOINT_Grid_CellSize);
+}
+
+
+/**
+ Removes a spawn point from collection.
+ @par point The spawn point.
+  */
+public func UnregisterCollection(object point)
+{
+	var points = collection_points[GetCell(point->GetX(), point->GetY())];
+
+	if (points != nil && IsValueInArray(points, point))
+	{
+		RemoveArrayValue(points, point, false);
+		collection_count--;
+	}
+}
+
+
+private func FxIntSpawnSchedulerTimer(object target, proplist effect_nr, int timer)
+{
+	var frame = FrameCounter();
+	ExecuteDue(frame);
+	ExecuteCollection(frame);
+	return FX_OK;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// collection grid
+
+
+private func ExecuteCollection(int frame)
+{
+	// no collectible spawn points, no searching
+	if (collection_count <= 0) return;
+
+	UpdateCrewGrid();
+	
+	for (var cell in crew_cells)
+	{
+		var x = cell % grid_columns;
+		var y = cell / grid_columns;
+		
+		for (var point_y = Max(0, y - collection_reach); point_y <= Min(grid_rows - 1, y + collection_reach); point_y++)
+		for (var point_x = Max(0, x - collection_reach); point_x <= Min(grid_columns - 1, x + collection_reach); point_x++)
+		{
+			var point_cell = point_x + point_y * grid_columns;
+			var points = collection_points[point_cell];
+			
+			if (points == nil || GetLength(points) == 0 || cell_checked[point_cell] == frame) continue;
+			
+			cell_checked[point_cell] = frame;
+			
+			var crew = GetCrewAround(point_x, point_y);
+
+			// copy, because the spawn points may unregister while collecting
+			for (var point in points[:])
+			{
+				if (point) point->CollectFromCrew(crew);
+			}
+		}
+	}
+}
+
+
+private func UpdateCrewGrid()
+{
+	for (var cell in crew_cells)
+	{
+		crew_grid[cell] = nil;
+	}
+	crew_cells = [];
+	
+	for (var crew in FindObjects(Find_OCF(OCF_CrewMember)))
+	{
+		var cell = GetCell(crew->GetX(), crew->GetY());
+		
+		if (crew_grid[cell] == nil)
+		{
+			crew_grid[cell] = [];
+			PushBack(crew_cells, cell);
+		}
+		
+		PushBack(crew_grid[cell], crew);
+	}
+}
+
+
+private func GetCrewAround(int x, int y)
+{
+	var crew = [];
+	
+	for (var cell_y = Max(0, y - collection_reach); cell_y <= Min(grid_rows - 1, y + collection_reach); cell_y++)
+	for (var cell_x = Max(0, x - collection_reach); cell_x <= Min(grid_columns - 1, x + collection_reach); cell_x++)
+	{
+		var cell_crew = crew_grid[cell_x + cell_y * grid_columns];
+		if (cell_crew != nil)
+		{
+			for (var clonk in cell_crew)
+			{
+				PushBack(crew, clonk);
+			}
+		}
+	}
+	
+	return crew;
+}
+
+
+private func GetCell(int x, int y)
+{
+	var cell_x = BoundBy(x / SPAWNPOINT_Grid_CellSize, 0, grid_columns - 1);
+	var cell_y = BoundBy(y / SPAWNPOINT_Grid_CellSize, 0, grid_rows - 1);
+	return cell_x + cell_y * grid_columns;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// min-heap
+
+
+private func HeapPush(proplist entry)
+{
+	var current = GetLength(schedule_heap);
+	schedule_heap[current] = entry;
+
+	while (current > 0)
+	{
+		var parent = (current - 1) / 2;
+
+		if (!IsEarlier(schedule_heap[current], schedule_heap[parent]))
+		{
+			break;
+		}
+
+		HeapSwap(current, parent);
+		current = parent;
+	}
+}
+
+
+private func HeapPop()
+{
+	var top = schedule_heap[0];
+	var last = PopBack(schedule_heap);
+	var size = GetLength(schedule_heap);
+
+	if (size == 0)
+	{
+		return top;
+	}
+
+	schedule_heap[0] = last;
+
+	var current = 0;
+	while (true)
+	{
+		var earliest = current;
+		var left = 2 * current + 1;
+		var right = left + 1;
+
+		if (left < size && IsEarlier(schedule_heap[left], schedule_heap[earliest]))
+		{
+			earliest = left;
+		}
+		if (right < size && IsEarlier(schedule_heap[right], schedule_heap[earliest]))
+		{
+			earliest = right;
+		}
+		if (earliest == current)
+		{
+			break;
+		}
+
+		HeapSwap(current, earliest);
+		current = earliest;
+	}
+
+	return top;
+}
+
+
+private func HeapSwap(int a, int b)
+{
+	var swap = schedule_heap[a];
+	schedule_heap[a] = schedule_heap[b];
+	schedule_heap[b] = swap;
+}
+
+
+private func IsEarlier(proplist entry, proplist other)
+{
+	if (entry.due == other.due)
+	{
+		return entry.order < other.order;
+	}
+	return entry.due < other.due;
+}
@@ -0,0 +1,243 @@
+/**
+ Collects statistics from {@link SpawnPoint#index spawn points}.@br
+ Spawn points record nothing as long as this object does not exist. Once it is created,
+ with {@link Arena_SpawnPointTelemetry#SpawnPointTelemetry}, every spawn point counts:
+ <table>
+ 	<tr><th>Counter</th>      <th>Description</th></tr>
+ 	<tr><td>spawns</td>       <td>Objects that were spawned.</td></tr>
+ 	<tr><td>collections</td>  <td>Objects that were collected.</td></tr>
+ 	<tr><td>failed</td>       <td>Collections that did not work, for example because the inventory was full.</td></tr>
+ 	<tr><td>rejected</td>     <td>Collections that the object rejected in {@c RejectCollectionFromSpawnPoint()}.</td></tr>
+ 	<tr><td>spawn_calls</td>  <td>Callbacks from the spawn point scheduler.</td></tr>
+ 	<tr><td>spawn_time</td>   <td>Script time in these callbacks, in milliseconds.</td></tr>
+ 	<tr><td>collect_calls</td><td>Collection checks.</td></tr>
+ 	<tr><td>collect_time</td> <td>Script time in these checks, in milliseconds.</td></tr>
+ </table>
+ The statistics can be queried per spawn point, or summed up for all spawn points with the same
+ {@link SpawnPoint#GetIDParameter id parameter}. The times are measured with {@c GetTime()}, so
+ they are only meaningful when summed up over many calls.
+ @title Spawn Point Telemetry
+ @id index
+ @author Marky
+*/
+
+static const SPAWNPOINT_Telemetry_Effect = "IntSpawnTelemetryLog";
+
+static spawn_point_telemetry; // object: the one and only telemetry object, see SpawnPointTelemetry()
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// definitions
+
+local Name = "Spawnpoint Telemetry";
+
+local telemetry_entries; // array: one entry per spawn point, an entry is a proplist with the counters, and:
+                         // * point - object: the spawn point
+                         // * key - string: the id parameter of the spawn point
+                         // * telemetry - object: this object
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// global functions
+
+/**
+ Gets the spawn point telemetry. The telemetry is created if it does not exist yet,
+ so calling this function enables the statistics.
+ @return object The {@link Arena_SpawnPointTelemetry#index telemetry} object.
+  */
+global func SpawnPointTelemetry()
+{
+	if (!spawn_point_telemetry)
+	{
+		spawn_point_telemetry = CreateObject(Arena_SpawnPointTelemetry, 0, 0, NO_OWNER);
+	}
+	return spawn_point_telemetry;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// finished functions
+
+protected func Initialize()
+{
+	telemetry_entries = [];
+}
+
+// Disabled, statistics are not part of the scenario
+public func SaveScenarioObject() { return false; }
+
+
+/**
+ Adds a spawn point to the statistics. Spawn points call this on their own.
+ @par point The spawn point.
+ @return proplist The entry for the spawn point. The spawn point increases the counters in it.
+  */
+public func AddPoint(object point)
+{
+	var entry = CreateEntry();
+	entry.point = point;
+	entry.key = GetKey(point);
+	entry.telemetry = this;
+
+	PushBack(telemetry_entries, entry);
+	return entry;
+}
+
+
+/**
+ Gets the statistics of a spawn point.
+ @par point The spawn point.
+ @return proplist The counters, see {@link Arena_SpawnPointTelemetry#index}.
+         All counters are 0 if the spawn point did not record anything.
+  */
+public func GetPointStatistics(object point)
+{
+	for (var entry in telemetry_entries)
+	{
+		if (entry.point == point)
+		{
+			return entry;
+		}
+	}
+	return CreateEntry();
+}
+
+
+/**
+ Gets the statistics of all spawn points with the same id parameter.
+ @par key The id parameter, as string. This is {@c Format("%v", point->GetIDParameter())}.
+ @return proplist The summed up counters, see {@link Arena_SpawnPointTelemetry#index}.
+  */
+public func GetStatistics(string key)
+{
+	return GetAggregated()[key] ?? CreateEntry();
+}
+
+
+/**
+ Gets the id parameters that have statistics.
+ @return array The keys for {@link Arena_SpawnPointTelemetry#GetStatistics}.
+  */
+public func GetKeys()
+{
+	return GetProperties(GetAggregated());
+}
+
+
+/**
+ Writes the statistics per id parameter to the log, most expensive first.
+  */
+public func LogStatistics()
+{
+	var aggregated = GetAggregated();
+	var sorted = [];
+	for (var key in GetProperties(aggregated))
+	{
+		var stats = aggregated[key];
+		PushBack(sorted, {key = key, stats = stats, cost = stats.spawn_time + stats.collect_time});
+	}
+	SortArrayByProperty(sorted, "cost", true);
+
+	Log("Spawn point telemetry, frame %d:", FrameCounter());
+	for (var line in sorted)
+	{
+		var stats = line.stats;
+		Log("* %s: %d points, %d spawns, %d collections, %d failed, %d rejected, %d/%d ms spawn/collect (%d/%d calls)",
+		    line.key, stats.points, stats.spawns, stats.collections, stats.failed, stats.rejected,
+		    stats.spawn_time, stats.collect_time, stats.spawn_calls, stats.collect_calls);
+	}
+}
+
+
+/**
+ Writes the statistics to the log periodically.
+ @par interval The statistics are logged every this many frames. Pass {@c nil} or 0
+               to stop logging.
+ @return object Returns the telemetry object, so that further function calls can be issued.
+  */
+public func SetLogInterval(int interval)
+{
+	RemoveEffect(SPAWNPOINT_Telemetry_Effect, this);
+
+	if (interval > 0)
+	{
+		AddEffect(SPAWNPOINT_Telemetry_Effect, this, 1, interval, this);
+	}
+	return this;
+}
+
+
+/**
+ Sets all counters to 0.
+  */
+public func Reset()
+{
+	// spawn points keep their entry, so the entries have to stay the same
+	var empty = CreateEntry();
+	for (var entry in telemetry_entries)
+	{
+		for (var counter in GetProperties(empty))
+		{
+			entry[counter] = 0;
+		}
+	}
+}
+
+
+private func FxIntSpawnTelemetryLogTimer(object target, proplist effect, int timer)
+{
+	LogStatistics();
+	return FX_OK;
+}
+
+
+private func CreateEntry()
+{
+	return {
+		spawns = 0,
+		collections = 0,
+		failed = 0,
+		rejected = 0,
+		spawn_calls = 0,
+		spawn_time = 0,
+		collect_calls = 0,
+		collect_time = 0,
+	};
+}
+
+
+private func GetKey(object point)
+{
+	return Format("%v", point->GetIDParameter());
+}
+
+
+private func GetAggregated()
+{
+	var aggregated = {};
+	var counters = GetProperties(CreateEntry());
+
+	for (var entry in telemetry_entries)
+	{
+		// the id parameter can change until the spawn point starts spawning
+		if (entry.point)
+		{
+			entry.key = GetKey(entry.point);
+		}
+
+		var stats = aggregated[entry.key];
+		if (stats == nil)
+		{
+			stats = CreateEntry();
+			stats.points = 0;
+			aggregated[entry.key] = stats;
+		}
+
+		stats.points++;
+		for (var counter in counters)
+		{
+			stats[counter] += entry[counter];
+		}
+	}
+	return aggregated;
+}
@@ -50,7 +50,11 @@ local configuration_rules;		// proplist, consists of:
 								// * def - id: the id of the rule
 								// * instances - array: all objects with the given id
 								// * is_active - bool: true, if the rule is configured
-								// * symbol - a symbol dummy for the menus
+								// * index - int: position in rule_keys, and bit in the rule masks
+
+local rule_keys;				// array: the keys of configuration_rules, in menu order
+local rule_conflicts;			// array: rule index to rule mask of the rules that exclude this rule if they are active
+local rule_requirements;		// array: rule index to rule mask of the rules that this rule requires
 
 local configured_items;			// proplist, structure not defined yet.
 								// * key - string: this identifies the 
@@ -69,9 +73,24 @@ local configured_goal;			// object: the goal that has been created
 local player_index;				// int: the player that configures the current round
 
 local configuration_finished;	// bool: true once the configuration is done
+local configuration_votes;		// array map: player number to the votes of that player, see CanConfigureInParallel(); a vote consists of:
+								// * goals - array, bool: the goals, in order of GetAvailableGoals(); true means, that the player wants the goal
+								// * rules - array, bool: the rules, in order of rule_keys; true means, that the player wants the rule
+								// * item_set - int: index of the item configuration that the player wants, or nil
+local configuration_snapshot;	// proplist: the configuration of the last round, see CreateConfigurationSnapshot()
+
+local bots_joining;				// int: bots that were created, but did not join yet
+local bots_leaving;				// array: player numbers of the bots that were eliminated, but were not removed yet
+local bots_removed;				// int: bots that are being removed right now; the engine counts them until RemovePlayer() is done
+local bots_target;				// int: the amount of bots that was requested in the bots menu, or nil if no change is pending
+local bots_menu;				// proplist: the bots menu that is updated once the requested bots joined or left, consists of:
+								// * player - object: the menu is displayed in this object
+								// * symbol - id: the menu has this icon
 
 local spawnpoint_keys; 				// array: contains spawnpoint keys.
+local spawnpoint_key_set;				// proplist: spawnpoint key to true, for the keys in spawnpoint_keys
 local spawnpoint_configurations;				// array: default configurations.
+local spawnpoint_fingerprints;				// array: fingerprints of the default configurations, see GetItemFingerprint()
 
 local color_conflict = -6946816; // = RGB(150, 0, 0);
 local color_inactive = -4934476; // = RGB(180, 180, 180);
@@ -128,6 +147,39 @@ public func CanConfigureTeams()
 }
 
 
+/**
+ Lets the other players vote on goals, rules and items while the choosing player configures the game,
+ if it returns {@c true}. The votes are merged with the configuration of the choosing player when the
+ configuration is finished, see {@link Environment_Configuration#MergeVotes}.
+ @return bool The default value is {@c false}.
+ */
+public func CanConfigureInParallel()
+{
+	return false;
+}
+
+
+/**
+ Adds an option to the main menu that repeats the configuration of the last round, if it returns {@c true}.
+ @return bool The default value is {@c true}.
+ */
+public func CanRepeatConfiguration()
+{
+	return true;
+}
+
+
+/**
+ Repeats the configuration of the last round without opening the main menu, if it returns {@c true}.
+ The first round is configured as usual.
+ @return bool The default value is {@c false}.
+ */
+public func AutoRepeatConfiguration()
+{
+	return false;
+}
+
+
 /**
  Tells objects, that this is a game configuration. This becomes important if you include the
  configuration object.
@@ -164,16 +216,30 @@ func MenuQueryCancel()
   */
 protected func Initialize()
 {
+	RegisterEnvironmentSingleton("GameConfiguration", this);
+	SubscribeRoundEvents(this);
+	
 	SetPosition();
 	configuration_rules = {};
 	configured_items = { key="default", name="default", icon = GAMECONFIG_Icon_DefaultItemConfiguration, items = {}};
 	
 	player_index = 0;
 	selected_goals = [];
+	configuration_votes = [];
+	
+	bots_joining = 0;
+	bots_leaving = [];
+	bots_removed = 0;
 	
 	// wait for other rules, etc. to be initialized
 	ScheduleCall(this, "PostInitialize", 1);
 }
+
+protected func Destruction()
+{
+	UnregisterEnvironmentSingleton("GameConfiguration", this);
+	ReleaseMenuIcons();
+}
 	
 protected func PostInitialize()
 {
@@ -201,6 +267,7 @@ public func OnRoundReset(int round_number)
 	// reset old configuration stuff
 	if (configured_goal) configured_goal->RemoveObject();
 	configuration_finished = false;
+	configuration_votes = [];
 	
 	// put players in spawn points
 	ContainPlayers(); 
@@ -209,7 +276,15 @@ public func OnRoundReset(int round_number)
 	var players  = GetPlayerCount(C4PT_User);
 	player_index = (round_number - 1) % players;
 	
-	OpenMainMenu();
+	if (AutoRepeatConfiguration() && configuration_snapshot != nil)
+	{
+		// wait for the other objects to register as round start blockers
+		ScheduleCall(this, "RepeatConfiguration", 1);
+	}
+	else
+	{
+		OpenMainMenu();
+	}
 }
 
 /**
@@ -217,9 +292,37 @@ public func OnRoundReset(int round_number)
   */
 public func InitializePlayer(int player, int x, int y, object base, int team, id extra_data)
 {
+	if (GetPlayerType(player) == C4PT_Script && bots_joining > 0)
+	{
+		bots_joining--;
+		ApplyBotTarget();
+		UpdateBotsMenu();
+	}
+
 	if (!configuration_finished)
 	{
 		ContainPlayer(player);
+		
+		if (CanConfigureInParallel() && GetCursor(player) != GetChoosingPlayer())
+		{
+			OpenVoteMenu(player);
+		}
+	}
+}
+
+/**
+ Engine callback. Updates the bots menu once the last bot that was eliminated in the menu is removed.
+  */
+public func RemovePlayer(int player, int team)
+{
+	if (IsValueInArray(bots_leaving, player))
+	{
+		RemoveArrayValue(bots_leaving, player);
+		
+		// the player is still counted by the engine until this callback is done
+		bots_removed++;
+		UpdateBotsMenu();
+		bots_removed--;
 	}
 }
 
@@ -245,13 +348,29 @@ protected func OpenMainMenu(id dummy)
 	{
 		var cursor = GetCursor(GetPlayerByIndex(i));
 		if (cursor != nil
-		&&  cursor->GetMenu())
+		&&  cursor->GetMenu()
+		&& (cursor == player || !CanConfigureInParallel()))
 			cursor->CloseMenu();
 	}
 	
 	Message("", player);
 	
 	CreateMainMenu(player);
+	
+	if (CanConfigureInParallel() && !configuration_finished)
+	{
+		for (var i = 0; i < GetPlayerCount(C4PT_User); i++)
+		{
+			var voter = GetPlayerByIndex(i, C4PT_User);
+			var cursor = GetCursor(voter);
+			
+			// players who are voting already keep their menu
+			if (cursor != nil && cursor != player && !cursor->GetMenu())
+			{
+				OpenVoteMenu(voter);
+			}
+		}
+	}
 		
 	// callback for effects, etc.
 	this->~OnOpenMainMenu();
@@ -266,7 +385,8 @@ protected func OpenMainMenu(id dummy)
  3.) {@link Environment_Configuration#MainMenuAddItemWinScore}@br
  4.) {@link Environment_Configuration#MainMenuAddItemRules}@br
  5.) Callback {@c MainMenuAddItemCustom(object player)}@br]
- 6.) {@link Environment_Configuration#MainMenuAddItemFinishConfiguration}
+ 6.) {@link Environment_Configuration#MainMenuAddItemRepeatConfiguration}@br
+ 7.) {@link Environment_Configuration#MainMenuAddItemFinishConfiguration}
  
  @par player The menu is displayed in this object.
   */
@@ -287,10 +407,13 @@ protected func CreateMainMenu(object player)
 	
 	if (main_menu_entry_amount > 0)
 	{
+		MainMenuAddItemRepeatConfiguration(player);
 		MainMenuAddItemFinishConfiguration(player);
+		ShowConfigurationMenu(player);
 	}
 	else
 	{
+		player->StopRecordingMenuItems();
 		player->CloseMenu();
 		ConfigurationFinished();
 	}
@@ -414,6 +537,20 @@ protected func MainMenuAddItemWinScore(object player)
 	}
 }
 
+/**
+ Adds an option that repeats the configuration of the last round, if {@link Environment_Configuration#CanRepeatConfiguration}
+ returns {@c true}. The option calls {@link Environment_Configuration#RepeatConfiguration}.
+ 
+ @par player The menu is displayed in this object.
+  */
+protected func MainMenuAddItemRepeatConfiguration(object player)
+{
+	if (CanRepeatConfiguration() && configuration_snapshot != nil)
+	{
+		player->AddMenuItem("$TxtRepeatConfiguration$", "RepeatConfiguration", GetIcon(GetID()), nil, nil, "$TxtRepeatConfiguration$");
+	}
+}
+
 /**
  Adds a finish option to a menu, the option calls {@link Environment_Configuration#ConfigurationFinished}.
  
@@ -476,7 +613,7 @@ protected func MenuChooseGoal(id menu_symbol, object player, int selection)
 	
 	if (has_selection) player->AddMenuItem("$Finished$", "SetupGoal()", Icon_Ok, nil, nil, "$Finished$");
 	
-	player->SelectMenuItem(selection);
+	ShowConfigurationMenu(player, selection);
 }
 
 /**
@@ -497,6 +634,13 @@ protected func MenuConfigureBots(id menu_symbol, object player, int selection, b
 	var number_bots = GetPlayerCount(C4PT_Script);
 	var number_players = GetPlayerCount();
 	
+	// show the requested amount while bots are still joining or leaving
+	if (bots_target != nil)
+	{
+		number_players += bots_target - number_bots;
+		number_bots = bots_target;
+	}
+	
 	var command0, command1, command2, command3;
 	var caption0 = Format("$TxtPlayersBots$", number_bots, number_players);
 	var caption1 = "$MoreBots$";
@@ -518,6 +662,11 @@ protected func MenuConfigureBots(id menu_symbol, object player, int selection, b
 	}
 	else
 	{
+		if (bots_target != nil)
+		{
+			caption0 = ColorizeString(caption0, color_inactive);
+		}
+
 		command0 = Format("MenuConfigureBots(%i, Object(%d), %d)", menu_symbol, player->ObjectNumber(), 0);
 		command1 = Format("ChangeBotAmount(%i, Object(%d), %d, %d)", menu_symbol, player->ObjectNumber(), 1, +1);
 		command2 = Format("ChangeBotAmount(%i, Object(%d), %d, %d)", menu_symbol, player->ObjectNumber(), 2, -1);
@@ -529,7 +678,7 @@ protected func MenuConfigureBots(id menu_symbol, object player, int selection, b
 	player->AddMenuItem(caption2, command2, Icon_Minus, nil, nil, "$LessBots$");
 	player->AddMenuItem(caption3, command3, Icon_Ok, nil, nil, "$Finished$");
 	
-	player->SelectMenuItem(selection);
+	ShowConfigurationMenu(player, selection);
 }
 
 /**
@@ -552,7 +701,7 @@ protected func MenuConfigureGoal(id menu_symbol, object player, int selection)
 
 	MenuAddItemReturn(player);
 
-	player->SelectMenuItem(selection);
+	ShowConfigurationMenu(player, selection);
 }
 
 /**
@@ -584,19 +733,7 @@ protected func MenuConfigureItems(id menu_symbol, object player, int selection)
 			
 			var caption = config.name;
 			
-			var selected = config.key == configured_items.key;
-			
-			for (var key in spawnpoint_keys)
-			{
-				var current = GetItemConfiguration(key);
-				var source = GetItemConfiguration(key, config);
-				
-				if (GetProperty(GAMECONFIG_Proplist_Def, current) != GetProperty(GAMECONFIG_Proplist_Def, source))
-				{
-					selected = false;
-					break;
-				}
-			}
+			var selected = IsItemSetSelected(i);
 			
 			if (selected)
 			{
@@ -614,7 +751,7 @@ protected func MenuConfigureItems(id menu_symbol, object player, int selection)
 
 		MenuAddItemReturn(player);
 		
-		player->SelectMenuItem(selection);
+		ShowConfigurationMenu(player, selection);
 	}
 	else
 	{
@@ -664,7 +801,7 @@ protected func MenuConfigureItemsCustom(id menu_symbol, object player, int selec
 		MenuAddItemReturn(player);
 	}
 	
-	player->SelectMenuItem(selection);
+	ShowConfigurationMenu(player, selection);
 }
 
 /**
@@ -713,7 +850,7 @@ protected func MenuConfigureItemSlot(id menu_symbol, object player, string key,
 	
 	player->AddMenuItem("$Finished$", Format("MenuConfigureItemsCustom(%i, Object(%d), %d, true)", menu_symbol, player->ObjectNumber(), index), Icon_Ok, nil, nil, "$Finished$");
 
-	player->SelectMenuItem(selection);
+	ShowConfigurationMenu(player, selection);
 }
 
 /**
@@ -734,64 +871,25 @@ protected func MenuConfigureRules(id menu_symbol, object player, int selection)
 	
 	var select = 0;
 	
-	var keys = GetProperties(configuration_rules);
+	var conflicts = ResolveRuleConflicts();
 	
-	for (var i = 0, check; i < GetLength(keys); i++)
+	for (var i = 0, check; i < GetLength(rule_keys); i++)
 	{
-		var rule_info = GetProperty(keys[i], configuration_rules);
+		var rule_info = GetRuleInfo(i);
 
-		var rule_id = rule_info.def;
-
-		var dummy = rule_info.symbol;
-		
-		var conflict = false;
+		var conflict = conflicts[i] != nil;
 		
 		var color = color_inactive;
 		
-		var rules_required = rule_id->~GameConfigRequiredRules();
-
-		for (var k = 0; k < GetLength(keys); k++)
+		if (conflicts[i] == "conflict")
 		{
-			if (k == i) continue; // it should not conflict with itself
-			
-			var conflict_info = GetProperty(keys[k], configuration_rules);
-			var conflict_id = conflict_info.def;
-			
-			var has_conflict = false, has_dependency = false;
-			
-			var rules_conflicts = conflict_id->~GameConfigConflictingRules();
-			
-			if (GetType(rules_conflicts) == C4V_Array
-		    &&  IsValueInArray(rules_conflicts, rule_id)
-		    &&  conflict_info.is_active)
-			{
-				has_conflict = true;
-				color = color_conflict;
-			}
-			
-			if (GetType(rules_required) == C4V_Array
-			&&  IsValueInArray(rules_required, conflict_id)
-			&& !conflict_info.is_active)
-			{
-				has_dependency = true;
-			}
-			
-			if (has_conflict || has_dependency)
-			{
-				rule_info.is_active = false;
-				conflict = true;
-				break;
-			}
+			color = color_conflict;
 		}
 		
-		
 		if (rule_info.is_active)
 		{
 			color = color_active;
 		}
-		else
-		{
-		}
 		
 		var command;
 		
@@ -804,7 +902,7 @@ protected func MenuConfigureRules(id menu_symbol, object player, int selection)
 			command = Format("ChangeRuleConf(%i, Object(%d), %d)", menu_symbol, player->ObjectNumber(), i);
 		}
 		
-		dummy->SetClrModulation(color);
+		var dummy = AcquireIconDummy(rule_info.def, color, this);
 		
 		player->AddMenuItem(ColorizeString(rule_info.def->GetName(), color), command, GetIcon(rule_info.def), nil, i, nil, 4, dummy);
 		
@@ -814,7 +912,7 @@ protected func MenuConfigureRules(id menu_symbol, object player, int selection)
 	}
 	
 	MenuAddItemReturn(player);
-	player->SelectMenuItem(select);
+	ShowConfigurationMenu(player, select);
 }
 
 /**
@@ -832,6 +930,7 @@ protected func MenuConfigureTeams(id menu_symbol, object player, int selection)
 	CreateConfigurationMenu(player, menu_symbol, "$TxtConfigureTeams$");
 	
 	var item = 0;
+	var select;
 	
 	for (var i = 0; i < GetTeamCount(); i++)
 	{
@@ -848,7 +947,7 @@ protected func MenuConfigureTeams(id menu_symbol, object player, int selection)
 				
 				if (selection != nil && index == selection)
 				{
-					player->SelectMenuItem(item);
+					select = item;
 				}
 				
 				item++;
@@ -857,6 +956,7 @@ protected func MenuConfigureTeams(id menu_symbol, object player, int selection)
 	}
 
 	MenuAddItemReturn(player);
+	ShowConfigurationMenu(player, select);
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------------------------
@@ -867,7 +967,7 @@ protected func MenuConfigureTeams(id menu_symbol, object player, int selection)
 
 protected func ChangeRuleConf(id menu_symbol, object player, int i)
 {
-	var rule_info = GetProperty(GetProperties(configuration_rules)[i], configuration_rules);
+	var rule_info = GetRuleInfo(i);
 
 	rule_info.is_active = !rule_info.is_active;
   
@@ -892,10 +992,26 @@ protected func ConfigurationFinished(id menu_symbol, parameter)
 
 	configuration_finished = true;
 	
+	// the menu is permanent and does not close on selection
+	var player = GetChoosingPlayer();
+	if (player && player->GetMenu())
+	{
+		player->CloseMenu();
+	}
+	
+	if (CanConfigureInParallel())
+	{
+		CloseVoteMenus();
+		MergeVotes();
+	}
+	
 	SetupGoal();
 	CreateRules();
 	ReleasePlayers();
 	
+	configuration_snapshot = CreateConfigurationSnapshot();
+	ReleaseMenuIcons();
+	
 	GameCallEx("OnConfigurationEnd", this);
 	
 	RoundManager()->RemoveRoundStartBlocker(this);
@@ -912,6 +1028,7 @@ protected func ConfigureItemSlot(id menu_symbol, object player, string key, int
 	
 	SetProperty(GAMECONFIG_Proplist_Def, item, current_config);
 	SetItemConfiguration(key, current_config);
+	UpdateItemFingerprint();
 
 	MenuConfigureItemSlot(menu_symbol, player, key, selection, configure_spawnpoint, index);
 }
@@ -926,25 +1043,55 @@ protected func CreateGoal(id goal_id)
 	}
 }
 
+/**
+ Creates the active rules and removes the inactive rules. Rules that are active already are kept, so
+ that they do not have to initialize again in every round. They get the callback {@c Configure(settings)},
+ same as new rules.@br
+ The rules are subscribed to the round events, see {@link global#SubscribeRoundEvents SubscribeRoundEvents()}, so that a rule that
+ is kept gets {@c OnRoundReset(round_number)} at the beginning of the next round and can reset its state there.
+  */
 protected func CreateRules()
 {
-	var keys = GetProperties(configuration_rules);
-	
-	for (var i = 0; i < GetLength(keys); i++)
+	for (var key in rule_keys)
 	{
-		var rule_info = GetProperty(keys[i], configuration_rules);
-		
-		RemoveAll(Find_ID(rule_info.def));
+		var rule_info = GetProperty(key, configuration_rules);
 		
 		if (rule_info.is_active)
 		{
-			var rule = CreateObject(rule_info.def);
+			var rule = GetRuleInstance(rule_info);
+			
+			if (rule == nil)
+			{
+				rule = CreateObject(rule_info.def);
+			}
+			
+			// there should be only one instance of the rule
+			for (var duplicate in FindObjects(Find_ID(rule_info.def), Find_Exclude(rule)))
+			{
+				duplicate->RemoveObject();
+			}
 			
 			rule->~Configure(rule_info.settings);
+			SubscribeRoundEvents(rule);
 			
 			rule_info.instances = [rule];
 		}
+		else if (GetLength(rule_info.instances) > 0 || FindObject(Find_ID(rule_info.def)))
+		{
+			RemoveAll(Find_ID(rule_info.def));
+			
+			rule_info.instances = [];
+		}
+	}
+}
+
+private func GetRuleInstance(proplist rule_info)
+{
+	for (var rule in rule_info.instances)
+	{
+		if (rule) return rule;
 	}
+	return FindObject(Find_ID(rule_info.def));
 }
 
 protected func PreconfigureRules()
@@ -981,157 +1128,491 @@ protected func ScanRules()
 			rule_proplist.def = rule_id;
 			rule_proplist.instances = FindObjects(Find_ID(rule_id));
 			rule_proplist.is_active = GetLength(rule_proplist.instances) > 0;
-			
-			var dummy = CreateObject(Dummy);
-			dummy->SetGraphics(nil, rule_id, 0, GFXOV_MODE_Picture);
-			
-			rule_proplist.symbol = dummy;
 
 			SetProperty(Format("%i", rule_id), rule_proplist, configuration_rules);
 		}
 	}
+	
+	rule_keys = GetProperties(configuration_rules);
+	ScanRuleDependencies();
 }
 
-protected func ScanSpawnPoints()
+
+/**
+ Deactivates rules that conflict with active rules or that miss a required rule.
+ @return array Rule index to the reason why the rule cannot be chosen: {@c "conflict"} if it
+         conflicts with an active rule, {@c "dependency"} if a required rule is not active,
+         {@c nil} if it can be chosen.
+  */
+protected func ResolveRuleConflicts()
 {
-	spawnpoint_keys = [];
-	var points = FindObjects(Find_Func("IsSpawnPoint"));
+	var conflicts = CreateArray(GetLength(rule_keys));
 	
-	spawnpoint_configurations = this->~GetDefaultItemConfigurations();
-
-	if (spawnpoint_configurations != nil)
+	var active = CreateRuleMask();
+	for (var i = 0; i < GetLength(rule_keys); i++)
 	{
-		configured_items = spawnpoint_configurations[0];
+		SetRuleMaskBit(active, i, GetRuleInfo(i).is_active);
 	}
 	
-	for (var spawnpoint in points)
+	for (var i = 0; i < GetLength(rule_keys); i++)
 	{
-		var key = spawnpoint->GetIDParameter();
+		if (RuleMaskIntersects(rule_conflicts[i], active))
+		{
+			conflicts[i] = "conflict";
+		}
+		else if (!RuleMaskContains(active, rule_requirements[i]))
+		{
+			conflicts[i] = "dependency";
+		}
 		
-		if (GetType(key) == C4V_String)
+		if (conflicts[i] != nil)
 		{
-			if (IsValueInArray(spawnpoint_keys, key)) continue;
-			
-			PushFront(spawnpoint_keys, key);
-			
-			var current_config = GetItemConfiguration(key);
+			GetRuleInfo(i).is_active = false;
+			SetRuleMaskBit(active, i, false);
+		}
+	}
+	return conflicts;
+}
+
+
+/**
+ Builds the rule masks for conflicts and requirements, so that the rules menu
+ does not have to ask every pair of rules about their conflicts.
+  */
+protected func ScanRuleDependencies()
+{
+	rule_conflicts = [];
+	rule_requirements = [];
+
+	for (var i = 0; i < GetLength(rule_keys); i++)
+	{
+		GetRuleInfo(i).index = i;
+		rule_conflicts[i] = CreateRuleMask();
+		rule_requirements[i] = CreateRuleMask();
+	}
 	
-			if (current_config == nil)
+	for (var i = 0; i < GetLength(rule_keys); i++)
+	{
+		var rule_id = GetRuleInfo(i).def;
+		
+		// an active rule excludes the rules that it conflicts with
+		var conflicts = rule_id->~GameConfigConflictingRules();
+		if (GetType(conflicts) == C4V_Array)
+		{
+			for (var conflict_id in conflicts)
 			{
-				current_config = {};
+				var conflict_info = GetProperty(Format("%i", conflict_id), configuration_rules);
+				if (conflict_info != nil && conflict_info.index != i)
+				{
+					SetRuleMaskBit(rule_conflicts[conflict_info.index], i, true);
+				}
+			}
+		}
+		
+		var required = rule_id->~GameConfigRequiredRules();
+		if (GetType(required) == C4V_Array)
+		{
+			for (var required_id in required)
+			{
+				var required_info = GetProperty(Format("%i", required_id), configuration_rules);
+				if (required_info != nil && required_info.index != i)
+				{
+					SetRuleMaskBit(rule_requirements[i], required_info.index, true);
+				}
 			}
-			
-			var desc = spawnpoint->~GetDescription();
-			
-			if (desc == nil || desc == "") desc = "Unknown";
-			
-			DebugLog("Checking spawnpoint type %s; config: %v", key, current_config);
-			
-			SetProperty(GAMECONFIG_Proplist_Desc, desc, current_config);
-			SetItemConfiguration(key, current_config);
 		}
 	}
-
 }
 
-private func ChangeBotAmount(id menu_symbol, object player, int selection, int change)
+protected func ScanSpawnPoints()
 {
-	var amount = Abs(change);
-	var delay;
+	spawnpoint_keys = [];
+	spawnpoint_key_set = {};
 	
-	if (change > 0)
+	spawnpoint_configurations = this->~GetDefaultItemConfigurations();
+
+	if (spawnpoint_configurations != nil)
 	{
-		AddBots(amount);
-		delay = 3;
+		// copy, so that configuring items does not change the default configuration
+		configured_items = CopyItemConfiguration(spawnpoint_configurations[0]);
 	}
-	else
+	
+	// spawn points register their keys on their own, see SpawnPoint::SetID()
+	for (var key in GetSpawnPointKeys())
 	{
-		RemoveBots(amount);
-		delay = 3;
+		AddSpawnPointKey(key);
 	}
-
-	// opens the menu right away, but updates the number
-	// as soon as a bot joins (waiting_for_bot_to_join)
-	MenuConfigureBots(GAMECONFIG_Icon_Bots, player, selection, true);
-	ScheduleCall(this, "MenuConfigureBots", delay, 0, GAMECONFIG_Icon_Bots, player, selection);
+	
+	UpdateItemFingerprints();
 }
 
-private func AddBots(int amount)
+
+/**
+ Callback from spawn points that are configured with a new key, or with a new description,
+ after the configuration object scanned the spawn points.
+ @par key The key, see {@link SpawnPoint#SetID}.
+  */
+public func OnSpawnPointRegistered(string key)
 {
-	// create a new ai player
-	while(amount > 0)
-	{
-		amount--;
-		AddBot();
-	}
+	// not scanned yet, the key will be picked up then
+	if (spawnpoint_keys == nil) return;
+	
+	AddSpawnPointKey(key);
+	UpdateItemFingerprints();
 }
 
-private func AddBot(string name, int color)
+
+/**
+ Callback from spawn points when no spawn point uses a key anymore,
+ after the configuration object scanned the spawn points.
+ The item configuration of the key is kept, in case that the key is used again.
+ @par key The key, see {@link SpawnPoint#SetID}.
+  */
+public func OnSpawnPointUnregistered(string key)
 {
-	CreateScriptPlayer(name ?? "$BotName$", color ?? HSL(Random(16) * 16, RandomX(200, 255), RandomX(100, 150)));
+	if (spawnpoint_keys == nil || !GetProperty(key, spawnpoint_key_set)) return;
+	
+	SetProperty(key, nil, spawnpoint_key_set);
+	RemoveArrayValue(spawnpoint_keys, key, false);
+	UpdateItemFingerprints();
 }
 
-private func RemoveBots(int amount)
+
+private func AddSpawnPointKey(string key)
 {
-	// eliminate the latest created ai players
-	for(var count = GetPlayerCount(C4PT_Script); count > 0 && amount > 0; count = GetPlayerCount(C4PT_Script))
+	if (!GetProperty(key, spawnpoint_key_set))
 	{
-		amount--;
-		EliminatePlayer(GetPlayerByIndex(count - 1, C4PT_Script), true);
+		SetProperty(key, true, spawnpoint_key_set);
+		PushBack(spawnpoint_keys, key);
 	}
-}
+	
+	var current_config = GetItemConfiguration(key);
 
-private func ConfigureItemSet(id menu_symbol, object player, int selection)
-{
-	if (spawnpoint_configurations != nil)
+	if (current_config == nil)
 	{
-		var configuration = spawnpoint_configurations[selection];
-		DebugLog("Set configuration to %s", configured_items.name);
-		
-		configured_items.key = configuration.key;
-		configured_items.name = configuration.name;
-		configured_items.icon = configuration.items;
-		
-		for (var key in spawnpoint_keys)
-		{
-			var update = GetItemConfiguration(key);
-			var source = GetItemConfiguration(key, configuration);
-		
-			for (var prop in GetProperties(source))
-			{
-				SetProperty(prop, GetProperty(prop, source), update);
-			}
-		
-			SetItemConfiguration(key, update);
-		}
+		current_config = {};
 	}
 	
-	MenuConfigureItems(GAMECONFIG_Icon_Items, player, selection);
+	var desc = GetSpawnPointDescription(key);
+	
+	if (desc == nil || desc == "") desc = "Unknown";
+	
+	DebugLog("Checking spawnpoint type %s; config: %v", key, current_config);
+	
+	SetProperty(GAMECONFIG_Proplist_Desc, desc, current_config);
+	SetItemConfiguration(key, current_config);
 }
 
-private func CreateConfigurationMenu(object player, id menu_symbol, string caption)
+
+private func UpdateItemFingerprints()
 {
-	player->CloseMenu();
-	player->CreateMenu(menu_symbol, this, nil, caption, nil, C4MN_Style_Context);
+	spawnpoint_fingerprints = [];
+	for (var i = 0; i < GetLength(spawnpoint_configurations); i++)
+	{
+		spawnpoint_fingerprints[i] = GetItemFingerprint(spawnpoint_configurations[i]);
+	}
+	UpdateItemFingerprint();
 }
 
-private func MenuAddItemReturn(object player)
+private func ChangeBotAmount(id menu_symbol, object player, int selection, int change)
 {
-	player->AddMenuItem("$Finished$", "OpenMainMenu()", Icon_Ok, nil, nil, "$Finished$");
+	// clicks add up while bots are still joining or leaving
+	bots_target = Max(0, (bots_target ?? GetBotCount()) + change);
+	bots_menu = {player = player, symbol = menu_symbol};
+	
+	ApplyBotTarget();
+	
+	if (!IsChangingBots())
+	{
+		bots_target = nil;
+		bots_menu = nil;
+	}
+
+	// shows the requested amount right away, the menu is updated
+	// once more when the last bot joined or left, see UpdateBotsMenu()
+	MenuConfigureBots(menu_symbol, player, selection);
 }
 
-private func ChooseGoal(id menu_symbol, id goal, object player, int selection)
+
+private func IsChangingBots()
 {
-	selected_goals[selection] = !selected_goals[selection];
+	return bots_joining > 0 || GetLength(bots_leaving) > 0;
+}
 
-	MenuChooseGoal(menu_symbol, player, selection);
+
+/**
+ Gets the amount of bots, including the bots that are joining and excluding the bots that are leaving.
+ @return int The amount of bots once all pending joins and eliminations are done.
+  */
+private func GetBotCount()
+{
+	return GetPlayerCount(C4PT_Script) + bots_joining - GetLength(bots_leaving) - bots_removed;
 }
 
-private func SetupGoal()
+
+/**
+ Creates or eliminates bots until the requested amount is reached. Bots that did not join yet
+ cannot be eliminated, so this is called again whenever a bot joins.
+  */
+private func ApplyBotTarget()
 {
-	var goals = this->~GetAvailableGoals();
+	if (bots_target == nil) return;
+
+	var difference = bots_target - GetBotCount();
 	
-	if (!configured_goal && goals)
+	if (difference > 0)
+	{
+		AddBots(difference);
+	}
+	else if (difference < 0)
+	{
+		RemoveBots(-difference);
+	}
+}
+
+
+/**
+ Updates the bots menu once, after the last requested bot joined or left.
+  */
+private func UpdateBotsMenu()
+{
+	if (IsChangingBots()) return;
+
+	var menu = bots_menu;
+	bots_target = nil;
+	bots_menu = nil;
+	
+	if (menu == nil || menu.player == nil) return;
+	
+	// the player may have left the menu in the meantime
+	var shown = menu.player.configuration_menu_shown;
+	if (menu.player->GetMenu() && shown != nil && shown.symbol == menu.symbol && shown.caption == "$TxtConfigureBots$")
+	{
+		MenuConfigureBots(menu.symbol, menu.player, menu.player->GetMenuSelection());
+	}
+}
+
+private func AddBots(int amount)
+{
+	// create a new ai player
+	while(amount > 0)
+	{
+		amount--;
+		AddBot();
+	}
+}
+
+private func AddBot(string name, int color)
+{
+	if (CreateScriptPlayer(name ?? "$BotName$", color ?? HSL(Random(16) * 16, RandomX(200, 255), RandomX(100, 150))))
+	{
+		bots_joining++;
+	}
+}
+
+private func RemoveBots(int amount)
+{
+	// eliminate the latest created ai players; eliminated players stay
+	// in the player list until they are removed, so skip those
+	for (var index = GetPlayerCount(C4PT_Script) - 1; index >= 0 && amount > 0; index--)
+	{
+		var bot = GetPlayerByIndex(index, C4PT_Script);
+		if (IsValueInArray(bots_leaving, bot)) continue;
+	
+		amount--;
+		PushBack(bots_leaving, bot);
+		EliminatePlayer(bot, true);
+	}
+}
+
+private func ConfigureItemSet(id menu_symbol, object player, int selection)
+{
+	ApplyItemSet(selection);
+	MenuConfigureItems(GAMECONFIG_Icon_Items, player, selection);
+}
+
+private func ApplyItemSet(int selection)
+{
+	if (spawnpoint_configurations != nil)
+	{
+		var configuration = spawnpoint_configurations[selection];
+		DebugLog("Set configuration to %s", configured_items.name);
+		
+		configured_items.key = configuration.key;
+		configured_items.name = configuration.name;
+		configured_items.icon = configuration.items;
+		
+		if (spawnpoint_fingerprints[selection] == configured_items.fingerprint) return;
+
+		for (var key in spawnpoint_keys)
+		{
+			var update = GetItemConfiguration(key);
+			var source = GetItemConfiguration(key, configuration);
+			
+			// copy only the slots that differ
+			if (GetProperty(GAMECONFIG_Proplist_Def, update) == GetProperty(GAMECONFIG_Proplist_Def, source)) continue;
+		
+			for (var prop in GetProperties(source))
+			{
+				SetProperty(prop, GetProperty(prop, source), update);
+			}
+		
+			SetItemConfiguration(key, update);
+		}
+		
+		UpdateItemFingerprint();
+	}
+}
+
+private func GetRuleInfo(int index)
+{
+	return GetProperty(rule_keys[index], configuration_rules);
+}
+
+
+/*
+ Rule masks are bit sets with one bit per rule index,
+ split into integers of 32 bits each.
+ */
+private func CreateRuleMask()
+{
+	var mask = CreateArray((GetLength(rule_keys) + 31) / 32);
+	for (var w = 0; w < GetLength(mask); w++)
+	{
+		mask[w] = 0;
+	}
+	return mask;
+}
+
+private func SetRuleMaskBit(array mask, int index, bool value)
+{
+	if (value)
+	{
+		mask[index / 32] |= 1 << (index % 32);
+	}
+	else
+	{
+		mask[index / 32] &= ~(1 << (index % 32));
+	}
+}
+
+private func RuleMaskIntersects(array mask, array other)
+{
+	for (var w = 0; w < GetLength(mask); w++)
+	{
+		if (mask[w] & other[w]) return true;
+	}
+	return false;
+}
+
+private func RuleMaskContains(array mask, array subset)
+{
+	for (var w = 0; w < GetLength(mask); w++)
+	{
+		if (subset[w] & ~mask[w]) return false;
+	}
+	return true;
+}
+
+/**
+ Starts a new menu in the player. The menu items are recorded, and the menu is displayed
+ by {@link Environment_Configuration#ShowConfigurationMenu}.
+ @par player The menu is displayed in this object.
+ @par menu_symbol The menu has this icon.
+ @par caption The menu has this caption.
+  */
+private func CreateConfigurationMenu(object player, id menu_symbol, string caption)
+{
+	player.configuration_menu_pending = {symbol = menu_symbol, caption = caption, items = player->RecordMenuItems()};
+}
+
+
+/**
+ Displays the menu that was started with {@link Environment_Configuration#CreateConfigurationMenu}.
+ The menu is compared with the menu that is open already: If it is the same menu, then it stays
+ open and only the items are replaced if they changed. Otherwise the old menu is closed and the
+ new menu is created.@br
+ The menus are permanent, so that selecting an item does not close them. Commands that leave
+ the configuration menus have to close the menu themselves.
+ @par player The menu is displayed in this object.
+ @par selection This option will be selected. First option is 0.
+  */
+private func ShowConfigurationMenu(object player, int selection)
+{
+	var menu = player.configuration_menu_pending;
+	if (menu == nil) return;
+
+	player->StopRecordingMenuItems();
+	player.configuration_menu_pending = nil;
+	
+	var shown = player.configuration_menu_shown;
+	var is_open = shown != nil
+	           && player->GetMenu() != nil
+	           && shown.symbol == menu.symbol
+	           && shown.caption == menu.caption;
+	
+	if (!is_open)
+	{
+		player->CloseMenu();
+		player->CreateMenu(menu.symbol, this, nil, menu.caption, nil, C4MN_Style_Context, true);
+		player->AddRecordedMenuItems(menu.items, this);
+	}
+	else if (!MenuItemsEqual(shown.items, menu.items))
+	{
+		player->ClearMenuItems();
+		player->AddRecordedMenuItems(menu.items, this);
+	}
+	
+	player.configuration_menu_shown = menu;
+	
+	if (selection != nil)
+	{
+		player->SelectMenuItem(selection);
+	}
+}
+
+
+private func MenuItemsEqual(array items, array other)
+{
+	if (GetLength(items) != GetLength(other)) return false;
+	
+	for (var i = 0; i < GetLength(items); i++)
+	{
+		for (var p = 0; p < GetLength(items[i]); p++)
+		{
+			if (items[i][p] != other[i][p]) return false;
+		}
+	}
+	return true;
+}
+
+/**
+ Releases the icon dummies of the configuration menus, see {@link Global#AcquireIconDummy}.
+ The configuration menus use the configuration as holder, so dummies that other menus
+ of the players need are not affected. The menus create them again if they are opened in a later round.
+  */
+private func ReleaseMenuIcons()
+{
+	ReleaseIconDummies(this);
+}
+
+private func MenuAddItemReturn(object player)
+{
+	player->AddMenuItem("$Finished$", "OpenMainMenu()", Icon_Ok, nil, nil, "$Finished$");
+}
+
+private func ChooseGoal(id menu_symbol, id goal, object player, int selection)
+{
+	selected_goals[selection] = !selected_goals[selection];
+
+	MenuChooseGoal(menu_symbol, player, selection);
+}
+
+private func SetupGoal()
+{
+	var goals = this->~GetAvailableGoals();
+	
+	if (!configured_goal && goals)
 	{
 		var multiple = [];
 		
@@ -1180,6 +1661,434 @@ private func MenuSwitchTeam(object player, int index)
 	MenuConfigureTeams(GAMECONFIG_Icon_Teams, player, index);
 }
 
+/*-----------------------------------------------------------------------------------------------------------------------------------------
+
+  Voting
+  
+  -----------------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ Opens the vote menu for a player who does not configure the game, if {@link Environment_Configuration#CanConfigureInParallel}
+ returns {@c true}.
+ @par player The player number.
+  */
+protected func OpenVoteMenu(int player)
+{
+	var cursor = GetCursor(player);
+	if (cursor == nil || GetPlayerType(player) != C4PT_User) return;
+
+	MenuVote(GetID(), cursor);
+}
+
+/**
+ Opens a menu with the options that a player can vote on.
+ @note Has a callback {@c OnMenuVote()}.
+ @par menu_symbol The menu has this icon.
+ @par player The menu is displayed in this object.
+ @par selection This option will be selected when the menu is open. First option is 0.
+  */
+protected func MenuVote(id menu_symbol, object player, int selection)
+{
+	this->~OnMenuVote();
+	
+	if (!player || configuration_finished) return;
+
+	CreateConfigurationMenu(player, GetIcon(GetID()), "$TxtVote$");
+	
+	var goals = this->~GetAvailableGoals();
+	if (CanConfigureGoal() && configured_goal == nil && goals != nil && GetLength(goals) > 1)
+	{
+		player->AddMenuItem("$TxtConfigureGoals$", "MenuVoteGoals", GAMECONFIG_Icon_Goals, nil, player);
+	}
+	
+	if (CanConfigureRules() && GetLength(rule_keys) > 0)
+	{
+		player->AddMenuItem("$TxtConfigureRules$", "MenuVoteRules", GAMECONFIG_Icon_Rules, nil, player);
+	}
+	
+	if (CanConfigureSpawnPoints() && spawnpoint_configurations != nil)
+	{
+		player->AddMenuItem("$TxtConfigureItems$", "MenuVoteItems", GAMECONFIG_Icon_Items, nil, player);
+	}
+	
+	ShowConfigurationMenu(player, selection);
+}
+
+/**
+ Lets a player vote on the goals. Every entry shows how many players want the goal.
+ @par menu_symbol The menu has this icon.
+ @par player The menu is displayed in this object.
+ @par selection This option will be selected when the menu is open. First option is 0.
+  */
+protected func MenuVoteGoals(id menu_symbol, object player, int selection)
+{
+	var goals = this->~GetAvailableGoals();
+	if (!player || !goals || configuration_finished) return;
+	
+	var vote = GetVote(player->GetOwner());
+
+	CreateConfigurationMenu(player, GAMECONFIG_Icon_Goals, "$TxtConfigureGoals$");
+	
+	for (var i = 0; i < GetLength(goals); i++)
+	{
+		var caption = Format("%s (%d)", goals[i]->GetName(), CountVotes("goals", i));
+		var command = Format("VoteGoal(%i, Object(%d), %d)", menu_symbol, player->ObjectNumber(), i);
+		player->AddMenuItem(ColorizeVote(caption, vote.goals[i]), command, GetIcon(goals[i]));
+	}
+	
+	MenuAddItemReturnVote(player);
+	ShowConfigurationMenu(player, selection);
+}
+
+/**
+ Lets a player vote on the rules. Every entry shows how many players want the rule.
+ @par menu_symbol The menu has this icon.
+ @par player The menu is displayed in this object.
+ @par selection This option will be selected when the menu is open. First option is 0.
+  */
+protected func MenuVoteRules(id menu_symbol, object player, int selection)
+{
+	if (!player || configuration_finished) return;
+
+	var vote = GetVote(player->GetOwner());
+
+	CreateConfigurationMenu(player, GAMECONFIG_Icon_Rules, "$TxtConfigureRules$");
+	
+	for (var i = 0; i < GetLength(rule_keys); i++)
+	{
+		var rule_id = GetRuleInfo(i).def;
+		var caption = Format("%s (%d)", rule_id->GetName(), CountVotes("rules", i));
+		var command = Format("VoteRule(%i, Object(%d), %d)", menu_symbol, player->ObjectNumber(), i);
+		player->AddMenuItem(ColorizeVote(caption, vote.rules[i]), command, GetIcon(rule_id));
+	}
+	
+	MenuAddItemReturnVote(player);
+	ShowConfigurationMenu(player, selection);
+}
+
+/**
+ Lets a player vote on the item configuration. Every entry shows how many players want the configuration.
+ @par menu_symbol The menu has this icon.
+ @par player The menu is displayed in this object.
+ @par selection This option will be selected when the menu is open. First option is 0.
+  */
+protected func MenuVoteItems(id menu_symbol, object player, int selection)
+{
+	if (!player || spawnpoint_configurations == nil || configuration_finished) return;
+
+	var vote = GetVote(player->GetOwner());
+
+	CreateConfigurationMenu(player, GAMECONFIG_Icon_Items, "$TxtConfigureItems$");
+	
+	for (var i = 0; i < GetLength(spawnpoint_configurations); i++)
+	{
+		var config = spawnpoint_configurations[i];
+		var caption = Format("%s (%d)", config.name, CountItemSetVotes(i));
+		var command = Format("VoteItemSet(%i, Object(%d), %d)", menu_symbol, player->ObjectNumber(), i);
+		player->AddMenuItem(ColorizeVote(caption, vote.item_set == i), command, GetIcon(config.icon));
+	}
+	
+	MenuAddItemReturnVote(player);
+	ShowConfigurationMenu(player, selection);
+}
+
+private func VoteGoal(id menu_symbol, object player, int selection)
+{
+	var vote = GetVote(player->GetOwner());
+	vote.goals[selection] = !vote.goals[selection];
+
+	MenuVoteGoals(menu_symbol, player, selection);
+}
+
+private func VoteRule(id menu_symbol, object player, int selection)
+{
+	var vote = GetVote(player->GetOwner());
+	vote.rules[selection] = !vote.rules[selection];
+
+	MenuVoteRules(menu_symbol, player, selection);
+}
+
+private func VoteItemSet(id menu_symbol, object player, int selection)
+{
+	var vote = GetVote(player->GetOwner());
+	if (vote.item_set == selection)
+	{
+		vote.item_set = nil;
+	}
+	else
+	{
+		vote.item_set = selection;
+	}
+
+	MenuVoteItems(menu_symbol, player, selection);
+}
+
+private func MenuAddItemReturnVote(object player)
+{
+	player->AddMenuItem("$Finished$", "MenuVote", Icon_Ok, nil, player, "$Finished$");
+}
+
+private func ColorizeVote(string caption, bool selected)
+{
+	if (selected)
+	{
+		return ColorizeString(caption, color_active);
+	}
+	else
+	{
+		return ColorizeString(caption, color_inactive);
+	}
+}
+
+private func GetVote(int player)
+{
+	if (configuration_votes[player] == nil)
+	{
+		configuration_votes[player] = {goals = [], rules = [], item_set = nil};
+	}
+	return configuration_votes[player];
+}
+
+private func CloseVoteMenus()
+{
+	var chooser = GetChoosingPlayer();
+
+	for (var i = 0; i < GetPlayerCount(C4PT_User); i++)
+	{
+		var cursor = GetCursor(GetPlayerByIndex(i, C4PT_User));
+		if (cursor != nil && cursor != chooser && cursor->GetMenu())
+		{
+			cursor->CloseMenu();
+		}
+	}
+}
+
+/**
+ Counts the votes for a goal or rule. The configuration of the choosing player counts as one vote.
+ @par category Either {@c "goals"} or {@c "rules"}.
+ @par index The goal or rule.
+ @return int The number of players who want the goal or rule.
+  */
+private func CountVotes(string category, int index)
+{
+	var count = 0;
+	
+	if (category == "goals" && selected_goals[index])
+	{
+		count++;
+	}
+	else if (category == "rules" && GetRuleInfo(index).is_active)
+	{
+		count++;
+	}
+	
+	for (var player = 0; player < GetLength(configuration_votes); player++)
+	{
+		var vote = configuration_votes[player];
+		if (vote != nil && GetPlayerName(player) && vote[category][index])
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+private func CountItemSetVotes(int index)
+{
+	var count = 0;
+	
+	if (IsItemSetSelected(index))
+	{
+		count++;
+	}
+
+	for (var player = 0; player < GetLength(configuration_votes); player++)
+	{
+		var vote = configuration_votes[player];
+		if (vote != nil && GetPlayerName(player) && vote.item_set == index)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+ Merges the votes of the players into the configuration. The configuration of the choosing
+ player counts as one vote:@br
+ - The goals with the most votes are selected, so that one of them is created.@br
+ - A rule is active if more than half of the voting players want it, the choosing player decides a tie.
+   Rules that conflict with active rules are deactivated afterwards.@br
+ - The item configuration with the most votes is used. The choosing player wins a tie.@br
+ Nothing changes if nobody voted.
+  */
+protected func MergeVotes()
+{
+	var voters = 0;
+	for (var player = 0; player < GetLength(configuration_votes); player++)
+	{
+		if (configuration_votes[player] != nil && GetPlayerName(player)) voters++;
+	}
+	if (voters == 0) return;
+	
+	var goals = this->~GetAvailableGoals();
+	if (configured_goal == nil && goals != nil)
+	{
+		var most = 0;
+		var counts = [];
+		for (var i = 0; i < GetLength(goals); i++)
+		{
+			counts[i] = CountVotes("goals", i);
+			most = Max(most, counts[i]);
+		}
+		for (var i = 0; i < GetLength(goals); i++)
+		{
+			selected_goals[i] = most > 0 && counts[i] == most;
+		}
+	}
+	
+	var participants = voters + 1;
+	var votes = [];
+	for (var i = 0; i < GetLength(rule_keys); i++)
+	{
+		votes[i] = CountVotes("rules", i);
+	}
+	for (var i = 0; i < GetLength(rule_keys); i++)
+	{
+		var rule_info = GetRuleInfo(i);
+		
+		// the choosing player decides a tie
+		if (2 * votes[i] != participants)
+		{
+			rule_info.is_active = 2 * votes[i] > participants;
+		}
+	}
+	ResolveRuleConflicts();
+	
+	if (spawnpoint_configurations != nil)
+	{
+		var best, best_count = 0;
+		for (var i = 0; i < GetLength(spawnpoint_configurations); i++)
+		{
+			var count = CountItemSetVotes(i);
+			var is_current = IsItemSetSelected(i);
+			
+			if (count > best_count || (count == best_count && is_current))
+			{
+				best = i;
+				best_count = count;
+			}
+		}
+		
+		if (best != nil && !IsItemSetSelected(best))
+		{
+			ApplyItemSet(best);
+		}
+	}
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------------------------
+
+  Configuration snapshots
+  
+  -----------------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ Finishes the configuration with the configuration of the last round.
+ Does the same as {@link Environment_Configuration#ConfigurationFinished} if there was no last round.
+ @par menu_symbol Dummy parameter from the menu selection call.
+ @par parameter Dummy parameter from the menu selection call.
+  */
+protected func RepeatConfiguration(id menu_symbol, parameter)
+{
+	if (configuration_finished) return;
+	
+	if (configuration_snapshot != nil)
+	{
+		RestoreConfigurationSnapshot(configuration_snapshot);
+		
+		// the last configuration wins over the votes
+		configuration_votes = [];
+	}
+
+	ConfigurationFinished();
+}
+
+
+/**
+ Saves the current configuration.
+ @return proplist The snapshot, consists of:@br
+         - goal - id: the configured goal, or {@c nil}@br
+         - win_score - int: the win score of the configured goal, or {@c nil}@br
+         - rules - proplist: rule key to a proplist with the properties {@c is_active} and {@c settings}@br
+         - items - proplist: a copy of the configured items
+  */
+public func CreateConfigurationSnapshot()
+{
+	var snapshot = {rules = {}};
+	
+	if (configured_goal != nil)
+	{
+		snapshot.goal = configured_goal->GetID();
+		snapshot.win_score = configured_goal->~GetWinScore();
+	}
+	
+	for (var key in rule_keys)
+	{
+		var rule_info = GetProperty(key, configuration_rules);
+		SetProperty(key, {is_active = rule_info.is_active, settings = rule_info.settings}, snapshot.rules);
+	}
+	
+	snapshot.items = CopyItemConfiguration(configured_items);
+	return snapshot;
+}
+
+
+/**
+ Restores a configuration that was saved with {@link Environment_Configuration#CreateConfigurationSnapshot}.
+ Rules that do not exist anymore are ignored.
+ @par snapshot The snapshot.
+  */
+public func RestoreConfigurationSnapshot(proplist snapshot)
+{
+	if (snapshot.goal != nil && configured_goal == nil)
+	{
+		var goals = this->~GetAvailableGoals();
+		if (goals != nil)
+		{
+			for (var i = 0; i < GetLength(goals); i++)
+			{
+				selected_goals[i] = goals[i] == snapshot.goal;
+			}
+		}
+
+		CreateGoal(snapshot.goal);
+		
+		// the goal could not be created
+		if (configured_goal)
+		{
+			var win_score = configured_goal->~GetWinScore();
+			if (snapshot.win_score != nil && win_score != nil)
+			{
+				configured_goal->~DoWinScore(snapshot.win_score - win_score);
+			}
+		}
+	}
+	
+	for (var key in rule_keys)
+	{
+		var saved = GetProperty(key, snapshot.rules);
+		if (saved == nil) continue;
+
+		var rule_info = GetProperty(key, configuration_rules);
+		rule_info.is_active = saved.is_active;
+		rule_info.settings = saved.settings;
+	}
+	
+	configured_items = CopyItemConfiguration(snapshot.items);
+	UpdateItemFingerprint();
+}
+
 /*-----------------------------------------------------------------------------------------------------------------------------------------
 
   Player and crew actions
@@ -1311,6 +2220,52 @@ private func SetItemConfiguration(string key, proplist value)
 	return SetProperty(key, value, GetProperty(GAMECONFIG_Proplist_Items, configured_items));
 }
 
+/**
+ Gets a fingerprint of the items in a configuration. Two configurations spawn the same items
+ at all configurable spawn points if their fingerprints are the same.
+ @par configuration The item configuration.
+ @return string The fingerprint.
+  */
+private func GetItemFingerprint(proplist configuration)
+{
+	var fingerprint = "";
+	for (var key in spawnpoint_keys)
+	{
+		fingerprint = Format("%s%i;", fingerprint, GetProperty(GAMECONFIG_Proplist_Def, GetItemConfiguration(key, configuration)));
+	}
+	return fingerprint;
+}
+
+private func IsItemSetSelected(int index)
+{
+	return spawnpoint_configurations[index].key == configured_items.key
+	    && spawnpoint_fingerprints[index] == configured_items.fingerprint;
+}
+
+private func UpdateItemFingerprint()
+{
+	configured_items.fingerprint = GetItemFingerprint(configured_items);
+}
+
+private func CopyItemConfiguration(proplist configuration)
+{
+	var copy = {key = configuration.key, name = configuration.name, icon = configuration.icon, items = {}};
+	var items = GetProperty(GAMECONFIG_Proplist_Items, configuration);
+
+	for (var key in GetProperties(items))
+	{
+		var slot = GetProperty(key, items);
+		var slot_copy = {};
+
+		for (var prop in GetProperties(slot))
+		{
+			SetProperty(prop, GetProperty(prop, slot), slot_copy);
+		}
+		SetProperty(key, slot_copy, copy.items);
+	}
+	return copy;
+}
+
 /**
  Allows overriding the icons for objects that appear in the game configuration.
  This function gets called by some of the AddMenuItem()-calls in this object.
@@ -3,25 +3,34 @@
  of finishing the scenario, the game starts merely a new round.
  {@section Script Architecture}
  There are phases and game calls for rounds:@br
- 1.) A game call is issued: {@c GameCallEx("OnRoundReset", round_number)}.
+ 1.) A call is issued: {@c OnRoundReset(round_number)}.
      Objects should create a default state for a new round in this call, for example
      players should be prevented from acting by putting them in spawn points.
      Use {@link Environment_RoundManager#RegisterRoundStartBlocker} here if you want to prevent the round from
      starting immediately.@br
  2.) Configuration Phase. This is completed once all round start blockers have removed themselves
      with {@link Environment_RoundManager#RemoveRoundStartBlocker}.@br
- 3.) A game call is issued: {@c GameCallEx("OnRoundStart", round_number)}.
+ 3.) A call is issued: {@c OnRoundStart(round_number)}.
      This is the point where interactive objects should be enabled, for example spawn points
      can spawn the players at this point.@br
      Use {@link Environment_RoundManager#RegisterRoundEndBlocker} here if you want to prevent the round from
      ending immediately.@br
  4.) Game phase. This is completed once all round end blockers have removed themselves
      with {@link Environment_RoundManager#RemoveRoundEndBlocker}.@br
- 5.) A game call is issued: {@c GameCallEx("OnRoundEnd", round_number)}. Remove undesired objects now.@br
+ 5.) A call is issued: {@c OnRoundEnd(round_number)}. Remove undesired objects now.@br
  6.) Repeat from 1.)@br
  @br
+ The calls are issued in the objects that subscribed with
+ {@link global#SubscribeRoundEvents SubscribeRoundEvents()} first, and in the scenario script last. Use {@link Library_PhaseManager#SetPhaseBroadcast}
+ for issuing them with {@c GameCallEx()} instead.@br
+ @br
  Note that a single {@link global#RoundManager RoundManager()} object will do one thing: Rush through the rounds quickly.
- It actually needs rules or goals that register as blockers for the phases.
+ It actually needs rules or goals that register as blockers for the phases.@br
+ @br
+ The phases are handled by the {@link Library_PhaseManager#index phase manager} library, so further phases
+ can be added with {@link Library_PhaseManager#AddPhase}. A phase is left in the same frame once nothing blocks
+ the next phase. Objects that register as blockers later than in the game call of a phase should set a minimum
+ duration for that phase, see {@link Library_PhaseManager#SetPhaseDwell}.
  {@section Constants}
  The object offers new constants:
  <table>
@@ -34,6 +43,8 @@
  @id index
  @author Marky
   */
+
+#include Library_PhaseManager
  
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -55,9 +66,30 @@ local Description = "$Description$";
   */
 global func RoundManager()
 {
-	var manager = FindObject(Find_ID(Environment_RoundManager));
-	
-	return manager;
+	return GetEnvironmentSingleton("RoundManager") ?? FindEnvironmentSingleton("RoundManager", Find_ID(Environment_RoundManager));
+}
+
+/**
+ Lets an object receive the calls {@c OnRoundReset()}, {@c OnRoundStart()} and {@c OnRoundEnd()}
+ of the {@link Environment_RoundManager#index round manager}. Objects that do not subscribe do not get
+ these calls, except for the scenario script. The subscription stays valid if the round manager is
+ created later.
+ @par subscriber The object.
+ @par priority Objects with a higher priority get the calls first. The default is 0.
+  */
+global func SubscribeRoundEvents(object subscriber, int priority)
+{
+	SubscribePhaseEvents("RoundManager", subscriber, priority);
+}
+
+/**
+ Stops an object from receiving the calls of the {@link Environment_RoundManager#index round manager}.
+ Objects that are removed are unsubscribed automatically.
+ @par subscriber The object.
+  */
+global func UnsubscribeRoundEvents(object subscriber)
+{
+	UnsubscribePhaseEvents("RoundManager", subscriber);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -71,14 +103,6 @@ static const ROUND_Callback_OnRoundStart = "OnRoundStart";
 static const ROUND_Callback_OnRoundEnd = "OnRoundEnd";
 
 
-// locals: internal information
-
-local round_counter;	 // int: the number of the current round. Starts at 1.
-local round_has_started; // bool: true - the round has started, enables countdown
-                         //       false - the round is inactive, for example when a chooser is running etc.
-local round_end_blocker; // array: the round cannot be finished until all of these objects have been removed
-local round_start_blocker; // dito
-
 // locals: configuration
 
 local cycle_chooser;	// bool: every player can configure a round once, in order?
@@ -90,18 +114,25 @@ local max_rounds;		// int:  the game automatically stops after this many rounds
 
 protected func Initialize()
 {
-	round_counter = 0; // on purpose
-	round_has_started = false;
+	RegisterEnvironmentSingleton("RoundManager", this);
+	SubscribeRoundEvents(this);
 	
 	cycle_chooser = false;
 	chooser_id = nil;
 	chooser_player = 0;
 	max_rounds = ROUND_Number_Default;
 	
-	round_end_blocker = CreateArray();
-	round_start_blocker = CreateArray();
-	
-	ScheduleCall(this, this.NextRound, 5, 0);
+	// the first reset waits for the other objects, the game configuration for example scans the rules one frame after its creation
+	InitPhases("RoundManager", [
+		{key = PHASE_Reset, callback = ROUND_Callback_OnRoundReset},
+		{key = PHASE_Start, callback = ROUND_Callback_OnRoundStart, active = true},
+		{key = PHASE_End,   callback = ROUND_Callback_OnRoundEnd}
+	], 5);
+}
+
+protected func Destruction()
+{
+	UnregisterEnvironmentSingleton("RoundManager", this);
 }
 
 /**
@@ -123,16 +154,13 @@ public func Activate(int player_index)
  @note The object has to tell the round manager that it is ready
        by calling {@link Environment_RoundManager#RemoveRoundStartBlocker}.
  @par blocker The object.
+ @par counted If {@c true}, then the object has to remove itself once per registration.
+              See {@link Library_PhaseManager#RegisterPhaseBlocker}.
  @related {@link Environment_RoundManager#RegisterRoundEndBlocker}
   */
-public func RegisterRoundStartBlocker(object blocker)
+public func RegisterRoundStartBlocker(object blocker, bool counted)
 {
-	CheckBlocker(blocker);
-
-	if (!IsValueInArray(round_start_blocker, blocker))
-	{
-		PushBack(round_start_blocker, blocker);
-	}
+	RegisterPhaseBlocker(PHASE_Start, blocker, counted);
 }
 
 /**
@@ -144,11 +172,7 @@ public func RegisterRoundStartBlocker(object blocker)
   */
 public func RemoveRoundStartBlocker(object blocker)
 {
-	CheckBlocker(blocker);
-
-	RemoveArrayValue(round_start_blocker, blocker, false);
-	
-	PrepareRoundStart();
+	RemovePhaseBlocker(PHASE_Start, blocker);
 }
 
 /**
@@ -157,16 +181,13 @@ public func RemoveRoundStartBlocker(object blocker)
  @note The object has to tell the round manager that it is ready
        by calling {@link Environment_RoundManager#RemoveRoundEndBlocker}.
  @par blocker The object.
+ @par counted If {@c true}, then the object has to remove itself once per registration.
+              See {@link Library_PhaseManager#RegisterPhaseBlocker}.
  @related {@link Environment_RoundManager#RegisterRoundStartBlocker}
   */
-public func RegisterRoundEndBlocker(object blocker)
+public func RegisterRoundEndBlocker(object blocker, bool counted)
 {
-	CheckBlocker(blocker);
-
-	if (!IsValueInArray(round_end_blocker, blocker))
-	{
-		PushBack(round_end_blocker, blocker);
-	}
+	RegisterPhaseBlocker(PHASE_End, blocker, counted);
 }
 
 /**
@@ -178,11 +199,7 @@ public func RegisterRoundEndBlocker(object blocker)
   */
 public func RemoveRoundEndBlocker(object blocker)
 {
-	CheckBlocker(blocker);
-
-	RemoveArrayValue(round_end_blocker, blocker, false);
-	
-	PrepareRoundEnd();
+	RemovePhaseBlocker(PHASE_End, blocker);
 }
 
 /**
@@ -192,7 +209,7 @@ public func RemoveRoundEndBlocker(object blocker)
   */
 public func IsRoundActive()
 {
-	return round_has_started;
+	return IsPhaseActive();
 }
 
 //---------- rection to game calls ----------//
@@ -207,98 +224,32 @@ protected func OnRoundReset(int round_number)
 		// has a chooser? Configure the settings!
 		if (cycle_chooser)
 		{
-			chooser_player = (round_counter - 1) % GetPlayerCount(C4PT_User);
+			chooser_player = (round_number - 1) % GetPlayerCount(C4PT_User);
 		}
 	}
-	
-	ScheduleCall(this, this.PrepareRoundStart, 5, 0);
 }
 
 
-//---------- internal calls ----------//
-
 /**
- Checks if the object actually exists and throws an error if not.
- @par blocker The blocker object.
- @ignore
-  */
-private func CheckBlocker(object blocker)
-{
-	if (blocker == nil)
-	{
-		FatalError(Format("Must specify an existing object! Parameter is %v", blocker));
-	}
-}
-
-/**
- Prepares a new round.
- Issues the game call {@c OnRoundEnd(int round_number)}, increases the round counter and calls {@c OnRoundReset(int round_number)}.
-  */
-private func NextRound()
-{
-	// increase round number
-	round_counter++;
-	
-	GameCallEx(ROUND_Callback_OnRoundReset, round_counter);
-}
-
-/**
- Gets called every time a round start blocker is removed.
-  */
-private func PrepareRoundStart()
-{
-	if (GetLength(round_start_blocker) == 0)
-	{
-		DoRoundStart();
-	}
-}
-
-/**
- Gets called every time a round end blocker is removed.
-  */
-private func PrepareRoundEnd()
-{
-	if (GetLength(round_end_blocker) == 0)
-	{
-		DoRoundEnd();
-		NextRound();
-	}
-}
-
-/**
- Issues the game call {@c GameCallEx("OnRoundEnd", round_number)}.
+ Gives the current round number.
+ @return int The number of the current round. It starts counting at 1 and increases before {@c GameCallEx("OnRoundReset")} is called.
   */
-private func DoRoundEnd()
+public func GetRoundNumber()
 {
-	if (round_has_started)
-	{
-		// reset the activity status
-		round_has_started = false;
-		GameCallEx(ROUND_Callback_OnRoundEnd, round_counter);
-	}
+	return GetPhaseCounter();
 }
 
-/**
- Issues the game call {@c GameCallEx("OnRoundStart", round_number)}.
-  */
-private func DoRoundStart()
-{
-	if (!round_has_started)
-	{
-		round_has_started = true;
-		GameCallEx(ROUND_Callback_OnRoundStart, round_counter);
-		
-		ScheduleCall(this, this.PrepareRoundEnd, 5, 0);
-	}
-}
 
 /**
- Gives the current round number.
- @return int The number of the current round. It starts counting at 1 and increases before {@c GameCallEx("OnRoundReset")} is called.
+ Gets the timing record of a round. Rounds are recorded only after
+ {@link Library_PhaseManager#SetPhaseProfiling} was called.
+ @par round_number The round.
+ @return proplist The record, see {@link Library_PhaseManager#GetPhaseProfile}.
+         The phases are {@c "reset"}, {@c "start"} and {@c "end"}.
   */
-public func GetRoundNumber()
+public func GetRoundProfile(int round_number)
 {
-	return round_counter;
+	return GetPhaseProfile(round_number);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
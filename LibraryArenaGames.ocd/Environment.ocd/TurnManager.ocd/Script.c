@@ -2,25 +2,34 @@
  This is a rule object that enables the game to run in turns.
  {@section Script Architecture}
  There are phases and game calls for turns:@br
- 1.) A game call is issued: {@c GameCallEx("OnTurnReset", turn_number)}.
+ 1.) A call is issued: {@c OnTurnReset(turn_number)}.
      Objects should create a default state for a new turn in this call, for example
      players should be prevented from acting by putting them in spawn points.
      Use {@link Environment_TurnManager#RegisterTurnStartBlocker} here if you want to prevent the turn from
      starting immediately.@br
  2.) Configuration Phase. This is completed once all turn start blockers have removed themselves
      with {@link Environment_TurnManager#RemoveTurnStartBlocker}.@br
- 3.) A game call is issued: {@c GameCallEx("OnTurnStart", turn_number)}.
+ 3.) A call is issued: {@c OnTurnStart(turn_number)}.
      This is the point where interactive objects should be enabled, for example spawn points
      can spawn the players at this point.@br
      Use {@link Environment_TurnManager#RegisterTurnEndBlocker} here if you want to prevent the turn from
      ending immediately.@br
  4.) Game phase. This is completed once all turn end blockers have removed themselves
      with {@link Environment_TurnManager#RemoveTurnEndBlocker}.@br
- 5.) A game call is issued: {@c GameCallEx("OnTurnEnd", turn_number)}. Remove undesired objects now.@br
+ 5.) A call is issued: {@c OnTurnEnd(turn_number)}. Remove undesired objects now.@br
  6.) Repeat from 1.)@br
  @br
+ The calls are issued in the objects that subscribed with
+ {@link global#SubscribeTurnEvents SubscribeTurnEvents()} first, and in the scenario script last. Use {@link Library_PhaseManager#SetPhaseBroadcast}
+ for issuing them with {@c GameCallEx()} instead.@br
+ @br
  Note that a single {@link global#TurnManager TurnManager()} object will do one thing: Rush through the turns quickly.
- It actually needs rules or goals that register as blockers for the phases.
+ It actually needs rules or goals that register as blockers for the phases.@br
+ @br
+ The phases are handled by the {@link Library_PhaseManager#index phase manager} library, so further phases
+ can be added with {@link Library_PhaseManager#AddPhase}. A phase is left in the same frame once nothing blocks
+ the next phase. Objects that register as blockers later than in the game call of a phase should set a minimum
+ duration for that phase, see {@link Library_PhaseManager#SetPhaseDwell}.
  {@section Constants}
  The object offers new constants:
  <table>
@@ -33,6 +42,8 @@
  @id index
  @author Marky
   */
+
+#include Library_PhaseManager
  
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,9 +64,30 @@ local Description = "$Description$";
   */
 global func TurnManager()
 {
-	var manager = FindObject(Find_ID(Environment_TurnManager));
-	
-	return manager;
+	return GetEnvironmentSingleton("TurnManager") ?? FindEnvironmentSingleton("TurnManager", Find_ID(Environment_TurnManager));
+}
+
+/**
+ Lets an object receive the calls {@c OnTurnReset()}, {@c OnTurnStart()} and {@c OnTurnEnd()}
+ of the {@link Environment_TurnManager#index turn manager}. Objects that do not subscribe do not get
+ these calls, except for the scenario script. The subscription stays valid if the turn manager is
+ created later.
+ @par subscriber The object.
+ @par priority Objects with a higher priority get the calls first. The default is 0.
+  */
+global func SubscribeTurnEvents(object subscriber, int priority)
+{
+	SubscribePhaseEvents("TurnManager", subscriber, priority);
+}
+
+/**
+ Stops an object from receiving the calls of the {@link Environment_TurnManager#index turn manager}.
+ Objects that are removed are unsubscribed automatically.
+ @par subscriber The object.
+  */
+global func UnsubscribeTurnEvents(object subscriber)
+{
+	UnsubscribePhaseEvents("TurnManager", subscriber);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -68,14 +100,6 @@ static const TURN_Callback_OnTurnReset = "OnTurnReset";
 static const TURN_Callback_OnTurnStart = "OnTurnStart";
 static const TURN_Callback_OnTurnEnd = "OnTurnEnd";
 
-// locals: internal information
-
-local turn_counter;	      // int: the number of the current turn. Starts at 1.
-local turn_has_started;   // bool: true - the turn has started, enables countdown
-                          //       false - the turn is inactive, for example when a chooser is running etc.
-local turn_end_blocker;   // array: the turn cannot be finished until all of these objects have been removed
-local turn_start_blocker; // dito
-
 // locals: configuration
 
 local max_turns;		// int:  the game automatically stops after this many turns
@@ -84,15 +108,21 @@ local max_turns;		// int:  the game automatically stops after this many turns
 
 protected func Initialize()
 {
-	turn_counter = 0; // on purpose
-	turn_has_started = false;
+	RegisterEnvironmentSingleton("TurnManager", this);
 	
 	max_turns = TURN_Number_Default;
 	
-	turn_end_blocker = CreateArray();
-	turn_start_blocker = CreateArray();
-	
-	ScheduleCall(this, this.NextTurn, 5, 0);
+	// the first reset waits for the other objects, the game configuration for example scans the rules one frame after its creation
+	InitPhases("TurnManager", [
+		{key = PHASE_Reset, callback = TURN_Callback_OnTurnReset},
+		{key = PHASE_Start, callback = TURN_Callback_OnTurnStart, active = true},
+		{key = PHASE_End,   callback = TURN_Callback_OnTurnEnd}
+	], 5);
+}
+
+protected func Destruction()
+{
+	UnregisterEnvironmentSingleton("TurnManager", this);
 }
 
 /**
@@ -114,16 +144,13 @@ public func Activate(int player_index)
  @note The object has to tell the turn manager that it is ready
        by calling {@link Environment_TurnManager#RemoveTurnStartBlocker}.
  @par blocker The object.
+ @par counted If {@c true}, then the object has to remove itself once per registration.
+              See {@link Library_PhaseManager#RegisterPhaseBlocker}.
  @related {@link Environment_TurnManager#RegisterTurnEndBlocker}
   */
-public func RegisterTurnStartBlocker(object blocker)
+public func RegisterTurnStartBlocker(object blocker, bool counted)
 {
-	CheckBlocker(blocker);
-
-	if (!IsValueInArray(turn_start_blocker, blocker))
-	{
-		PushBack(turn_start_blocker, blocker);
-	}
+	RegisterPhaseBlocker(PHASE_Start, blocker, counted);
 }
 
 /**
@@ -135,11 +162,7 @@ public func RegisterTurnStartBlocker(object blocker)
   */
 public func RemoveTurnStartBlocker(object blocker)
 {
-	CheckBlocker(blocker);
-
-	RemoveArrayValue(turn_start_blocker, blocker, false);
-	
-	PrepareTurnStart();
+	RemovePhaseBlocker(PHASE_Start, blocker);
 }
 
 /**
@@ -148,16 +171,13 @@ public func RemoveTurnStartBlocker(object blocker)
  @note The object has to tell the turn manager that it is ready
        by calling {@link Environment_TurnManager#RemoveTurnEndBlocker}.
  @par blocker The object.
+ @par counted If {@c true}, then the object has to remove itself once per registration.
+              See {@link Library_PhaseManager#RegisterPhaseBlocker}.
  @related {@link Environment_TurnManager#RegisterTurnStartBlocker}
   */
-public func RegisterTurnEndBlocker(object blocker)
+public func RegisterTurnEndBlocker(object blocker, bool counted)
 {
-	CheckBlocker(blocker);
-
-	if (!IsValueInArray(turn_end_blocker, blocker))
-	{
-		PushBack(turn_end_blocker, blocker);
-	}
+	RegisterPhaseBlocker(PHASE_End, blocker, counted);
 }
 
 /**
@@ -169,11 +189,7 @@ public func RegisterTurnEndBlocker(object blocker)
   */
 public func RemoveTurnEndBlocker(object blocker)
 {
-	CheckBlocker(blocker);
-
-	RemoveArrayValue(turn_end_blocker, blocker, false);
-	
-	PrepareTurnEnd();
+	RemovePhaseBlocker(PHASE_End, blocker);
 }
 
 /**
@@ -183,95 +199,7 @@ public func RemoveTurnEndBlocker(object blocker)
   */
 public func IsTurnActive()
 {
-	return turn_has_started;
-}
-
-//---------- rection to game calls ----------//
-
-/**
- GameCall when the turn is reset. 
-  */
-protected func OnTurnReset(int turn_number)
-{
-	ScheduleCall(this, this.PrepareTurnStart, 5, 0);
-}
-
-
-//---------- internal calls ----------//
-
-/**
- Checks if the object actually exists and throws an error if not.
- @par blocker The blocker object.
- @ignore
-  */
-private func CheckBlocker(object blocker)
-{
-	if (blocker == nil)
-	{
-		FatalError(Format("Must specify an existing object! Parameter is %v", blocker));
-	}
-}
-
-/**
- Prepares a new turn.
- Issues the game call {@c OnTurnEnd(int turn_number)}, increases the turn counter and calls {@c OnTurnReset(int turn_number)}.
-  */
-private func NextTurn()
-{
-	// increase turn number
-	turn_counter++;
-
-	GameCallEx(TURN_Callback_OnTurnReset, turn_counter);
-}
-
-/**
- Gets called every time a turn start blocker is removed.
-  */
-private func PrepareTurnStart()
-{
-	if (GetLength(turn_start_blocker) == 0)
-	{
-		DoTurnStart();
-	}
-}
-
-/**
- Gets called every time a turn end blocker is removed.
-  */
-private func PrepareTurnEnd()
-{
-	if (GetLength(turn_end_blocker) == 0)
-	{
-		DoTurnEnd();
-		NextTurn();
-	}
-}
-
-/**
- Issues the game call {@c GameCallEx("OnTurnEnd", turn_number)}.
-  */
-private func DoTurnEnd()
-{
-	// reset the activity status
-	if (turn_has_started)
-	{
-		turn_has_started = false;
-		GameCallEx(TURN_Callback_OnTurnEnd, turn_counter);
-	}
-}
-
-/**
- Issues the game call {@c GameCallEx("OnTurnStart", turn_number)}.
-  */
-private func DoTurnStart()
-{
-	if (!turn_has_started)
-	{
-		turn_has_started = true;
-		GameCallEx(TURN_Callback_OnTurnStart, turn_counter);
-		
-		ScheduleCall(this, this.PrepareTurnEnd, 5, 0);
-	}
+	return IsPhaseActive();
 }
 
 /**
@@ -280,7 +208,7 @@ private func DoTurnStart()
   */
 public func GetTurnNumber()
 {
-	return turn_counter;
+	return GetPhaseCounter();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
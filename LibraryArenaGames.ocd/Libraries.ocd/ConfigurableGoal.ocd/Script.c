@@ -190,6 +190,8 @@ protected func Initialize()
 	
 	win_score = Max(1, this->~GetDefaultWinScore());
 	
+	SubscribeRoundEvents(this);
+	
 	if (RoundManager() != nil)
 	{
 		RoundManager()->RegisterRoundEndBlocker(this);
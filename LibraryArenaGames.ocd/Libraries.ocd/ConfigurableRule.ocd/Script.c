@@ -6,6 +6,17 @@
 
 #include Library_BasicRule
 
+/**
+ Subscribes the rule to the round events, so that it gets {@c OnRoundReset},
+ {@c OnRoundStart} and {@c OnRoundEnd}, see {@link global#SubscribeRoundEvents SubscribeRoundEvents()}.
+ */
+func Initialize()
+{
+	// subscribe first, the basic rule removes additional instances
+	SubscribeRoundEvents(this);
+	return _inherited(...);
+}
+
 /**
  Marks the rule as configurable for {@link Environment_Configuration#index}.
  @return {@c true}
@@ -0,0 +1,822 @@
+/**
+ Library for objects that run the game in cycles of phases, such as the {@link Environment_RoundManager#index round manager}
+ and the {@link Environment_TurnManager#index turn manager}.@br
+ @br
+ A cycle consists of phases that are entered in order. Entering a phase issues a call
+ {@c callback(counter)} in the objects that subscribed to the manager, see {@link Global#SubscribePhaseEvents},
+ and then in the scenario script. Objects can prevent a phase from being entered by
+ registering as blockers for that phase, see {@link Library_PhaseManager#RegisterPhaseBlocker}.
+ The manager enters the next phase as soon as nothing blocks it, in the same frame. Phases can
+ have a minimum duration, see {@link Library_PhaseManager#SetPhaseDwell}. Once the last phase is
+ over, the counter increases and the cycle starts again with the first phase. A new cycle starts
+ at most once per frame, so that a manager without blockers does not loop forever.@br
+ @br
+ Further phases, such as a warmup before the start, can be inserted with {@link Library_PhaseManager#AddPhase}.@br
+ @br
+ Managers can be nested, see {@link Library_PhaseManager#SetPhaseParent}. All managers are driven
+ by a single scheduler, and parents are always checked before their children.@br
+ @br
+ The manager can record when each phase was entered, how long the calls took and how
+ long the blockers held the phases, see {@link Library_PhaseManager#SetPhaseProfiling}.
+ @title Phase Manager
+ @id index
+ @author Marky
+  */
+
+static const PHASE_Scheduler_Effect = "IntPhaseScheduler";
+static const PHASE_Sweep_Interval = 36;
+static const PHASE_Profile_History = 100;
+
+static const PHASE_Reset = "reset";
+static const PHASE_Start = "start";
+static const PHASE_End = "end";
+
+static phase_managers; // array: all phase managers, parents before their children
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// definitions
+
+local phase_name;       // string: the name of the manager, for subscriptions
+local phase_broadcast;  // bool: issue the calls with GameCallEx(), see SetPhaseBroadcast()
+local phase_list;       // array: the phases in order, a phase consists of:
+                        // * key - string: identifies the phase, for example PHASE_Start
+                        // * callback - string: this game call is issued when the phase is entered
+                        // * dwell - int: the phase lasts at least this many frames; a phase without dwell
+                        //                is left in the same frame if nothing blocks the next phase
+                        // * active - bool: the cycle counts as active during this phase, see IsPhaseActive()
+local phase_index;      // int: the current phase
+local phase_counter;    // int: the number of the current cycle. Starts at 1.
+local phase_blockers;   // proplist: phase key to the objects that prevent the phase from being entered, consists of:
+                        // * size - int: the number of blockers
+                        // * entries - proplist: object number to an entry, which consists of:
+                        //   * blocker - object: the blocker; if the object is removed, it is swept after some time
+                        //   * count - int: the number of registrations, see RegisterPhaseBlocker()
+local phase_due;        // int: the frame in which the next phase is checked, or nil
+local phase_entered;    // int: the frame in which the current phase was entered
+local phase_cycle_frame;// int: the frame in which the current cycle started
+local phase_busy;       // bool: true while a phase is being entered
+local phase_parent;     // object: the manager that this manager is nested in, or nil
+local phase_parent_key; // string: this manager starts new cycles only while the parent is in this phase
+local phase_children;   // array: the managers that are nested in this manager
+
+local phase_profiling;    // bool: records the cycles, see SetPhaseProfiling()
+local phase_profile_log;  // bool: logs every cycle once it is over
+local phase_profiles;     // array: the recorded cycles, the latest at the end, see GetPhaseProfile()
+local phase_profile_open; // proplist: phase key and object number to the blocker records that were not released yet
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// finished functions
+
+/**
+ Sets up the phases. Call this in {@c Initialize()} of the object that includes the library.
+ The first cycle starts with the first phase.
+ @par name The name of the manager. Objects subscribe to the manager with this name.
+ @par phases The phases in order, see {@link Library_PhaseManager#AddPhase}.
+ @par delay The first phase is entered this many frames later, at least 1 frame later.
+  */
+protected func InitPhases(string name, array phases, int delay)
+{
+	phase_name = name;
+	phase_broadcast = false;
+	phase_list = [];
+	phase_blockers = {};
+	phase_children = [];
+	phase_counter = 0; // on purpose
+
+	for (var phase in phases)
+	{
+		AddPhase(phase);
+	}
+
+	// nothing happened yet, so the manager is at the end of a cycle
+	phase_index = GetLength(phase_list) - 1;
+	phase_entered = FrameCounter();
+	phase_cycle_frame = -1;
+
+	RegisterPhaseManager(this);
+	SchedulePhaseCheck(Max(1, delay));
+}
+
+
+/**
+ Adds a phase to the cycle.
+ @par phase The phase, consists of:@br
+            - key - string: identifies the phase, for blockers and for {@link Library_PhaseManager#GetPhase}@br
+            - callback - string: this game call is issued when the phase is entered, with the counter as parameter@br
+            - dwell - int: the phase lasts at least this many frames, see {@link Library_PhaseManager#SetPhaseDwell}@br
+            - active - bool: {@link Library_PhaseManager#IsPhaseActive} returns {@c true} during this phase
+ @par before The phase is inserted before the phase with this key. Pass {@c nil} for adding it at the end.
+ @return object The manager, for further function calls.
+  */
+public func AddPhase(proplist phase, string before)
+{
+	if (phase == nil || phase.key == nil)
+	{
+		FatalError(Format("A phase needs a key, got %v", phase));
+	}
+	if (GetPhaseIndex(phase.key) != nil)
+	{
+		FatalError(Format("There is a phase with the key %s already", phase.key));
+	}
+
+	var position = GetLength(phase_list);
+	if (before != nil)
+	{
+		position = GetPhaseIndex(before);
+
+		if (position == nil)
+		{
+			FatalError(Format("There is no phase with the key %s", before));
+		}
+	}
+
+	for (var i = GetLength(phase_list); i > position; i--)
+	{
+		phase_list[i] = phase_list[i - 1];
+	}
+	phase_list[position] = phase;
+
+	if (phase_index != nil && phase_index >= position)
+	{
+		phase_index++;
+	}
+	return this;
+}
+
+
+/**
+ Sets the minimum duration of a phase. The next phase is not entered before
+ this many frames have passed, even if nothing blocks it. Objects that register
+ as blockers some frames after the game call of the phase need this.
+ @par key The phase.
+ @par frames The minimum duration. Pass 0 for leaving the phase as soon as nothing blocks the next phase.
+ @return object The manager, for further function calls.
+  */
+public func SetPhaseDwell(string key, int frames)
+{
+	var index = GetPhaseIndex(key);
+	if (index == nil)
+	{
+		FatalError(Format("There is no phase with the key %s", key));
+	}
+
+	phase_list[index].dwell = Max(0, frames);
+	return this;
+}
+
+
+/**
+ Issues the calls of the phases with {@c GameCallEx()}, as older versions did, if set to {@c true}.
+ Then all goals, rules and environment objects get the calls, even if they did not subscribe to
+ the manager. Subscribed objects of other categories still get the calls.
+ @par broadcast {@c true} for issuing the calls with {@c GameCallEx()}. The default is {@c false}.
+ @return object The manager, for further function calls.
+  */
+public func SetPhaseBroadcast(bool broadcast)
+{
+	phase_broadcast = broadcast;
+	return this;
+}
+
+
+/**
+ Nests this manager in another manager: New cycles start only while the other
+ manager is in the given phase, and the current cycle ends when the other manager
+ leaves that phase. For example, turns can run inside the active phase of rounds.
+ @par parent The other manager. Pass {@c nil} for running independently again.
+ @par key The phase of the other manager.
+ @return object The manager, for further function calls.
+  */
+public func SetPhaseParent(object parent, string key)
+{
+	if (phase_parent != nil)
+	{
+		phase_parent->RemovePhaseChild(this);
+	}
+
+	phase_parent = parent;
+	phase_parent_key = key;
+
+	if (phase_parent != nil)
+	{
+		phase_parent->AddPhaseChild(this);
+	}
+
+	// parents are scheduled before their children
+	RegisterPhaseManager(this);
+	return this;
+}
+
+
+/**
+ Recognizes an object, so that the phase is not entered until
+ this object tells the manager that it is ready.
+ @note The object has to tell the manager that it is ready
+       by calling {@link Library_PhaseManager#RemovePhaseBlocker}.
+       Objects that are removed without doing so stop blocking
+       the phase after a short time.
+ @par key The phase.
+ @par blocker The object.
+ @par counted By default, registering an object again has no effect.
+              If this is {@c true}, then the registrations are counted
+              instead, and the object has to remove itself once per
+              registration.
+  */
+public func RegisterPhaseBlocker(string key, object blocker, bool counted)
+{
+	CheckBlocker(blocker);
+
+	var blockers = GetPhaseBlockers(key);
+	var number = GetBlockerKey(blocker);
+	var entry = GetProperty(number, blockers.entries);
+
+	if (entry == nil)
+	{
+		SetProperty(number, {blocker = blocker, count = 1}, blockers.entries);
+		blockers.size++;
+		
+		if (phase_profiling) ProfileBlockerRegistered(key, number, blocker);
+	}
+	else if (counted)
+	{
+		entry.count++;
+	}
+}
+
+
+/**
+ Tells the manager, that the object does not prevent the phase
+ from being entered anymore. The phase is entered if it is the next
+ phase and if no object blocks it.
+ @par key The phase.
+ @par blocker The object.
+  */
+public func RemovePhaseBlocker(string key, object blocker)
+{
+	CheckBlocker(blocker);
+
+	var blockers = GetPhaseBlockers(key);
+	var number = GetBlockerKey(blocker);
+	var entry = GetProperty(number, blockers.entries);
+
+	if (entry != nil)
+	{
+		entry.count--;
+
+		if (entry.count > 0) return;
+
+		SetProperty(number, nil, blockers.entries);
+		blockers.size--;
+		
+		if (phase_profiling) ProfileBlockerReleased(key, number);
+	}
+
+	if (key == GetPhaseKey(GetNextPhaseIndex()))
+	{
+		CheckPhaseTransition();
+	}
+}
+
+
+/**
+ Gets the objects that block a phase.
+ @par key The phase.
+ @return array The blockers.
+  */
+public func GetPhaseBlockerList(string key)
+{
+	var blockers = GetPhaseBlockers(key);
+	var list = [];
+
+	for (var number in GetProperties(blockers.entries))
+	{
+		var entry = GetProperty(number, blockers.entries);
+		if (entry != nil && entry.blocker != nil)
+		{
+			PushBack(list, entry.blocker);
+		}
+	}
+	return list;
+}
+
+
+/**
+ Records the cycles: The frame in which each phase was entered, how long the calls of the phase
+ took, and which objects blocked the phases for how long. The latest cycles are kept, see
+ {@link Library_PhaseManager#GetPhaseProfile}.
+ @par profiling {@c true} starts recording, {@c false} stops recording. The recorded cycles are kept.
+ @par log If {@c true}, then every cycle is logged once it is over, see {@link Library_PhaseManager#LogPhaseProfile}.
+ @return object The manager, for further function calls.
+  */
+public func SetPhaseProfiling(bool profiling, bool log)
+{
+	phase_profiling = profiling;
+	phase_profile_log = profiling && log;
+	
+	if (phase_profiles == nil)
+	{
+		phase_profiles = [];
+		phase_profile_open = {};
+	}
+	return this;
+}
+
+
+/**
+ Gets the record of a cycle, see {@link Library_PhaseManager#SetPhaseProfiling}.
+ @par counter The number of the cycle.
+ @return proplist The record, or {@c nil} if the cycle was not recorded. It consists of:@br
+         - counter - int: the number of the cycle@br
+         - phases - proplist: phase key to a proplist with the properties {@c frame}, the frame in which the phase
+           was entered, and {@c time}, the time in milliseconds that the calls of the phase took@br
+         - blockers - array: the blockers that were registered during the cycle, each with the properties
+           {@c phase}, {@c name}, {@c registered} and {@c released}. The last two are frames, {@c released} is
+           {@c nil} while the object still blocks the phase.
+  */
+public func GetPhaseProfile(int counter)
+{
+	for (var profile in phase_profiles)
+	{
+		if (profile.counter == counter) return profile;
+	}
+	return nil;
+}
+
+
+/**
+ Logs the record of a cycle: How many frames each phase lasted, how long its calls took,
+ and how long each blocker held its phase.
+ @par counter The number of the cycle.
+  */
+public func LogPhaseProfile(int counter)
+{
+	var profile = GetPhaseProfile(counter);
+	if (profile == nil) return;
+
+	var next_profile = GetPhaseProfile(counter + 1);
+	
+	for (var i = 0; i < GetLength(phase_list); i++)
+	{
+		var key = GetPhaseKey(i);
+		var phase = GetProperty(key, profile.phases);
+		if (phase == nil) continue;
+		
+		var next_phase;
+		if (i + 1 < GetLength(phase_list))
+		{
+			next_phase = GetProperty(GetPhaseKey(i + 1), profile.phases);
+		}
+		else if (next_profile != nil)
+		{
+			next_phase = GetProperty(GetPhaseKey(0), next_profile.phases);
+		}
+		
+		var duration = "-";
+		if (next_phase != nil)
+		{
+			duration = Format("%d", next_phase.frame - phase.frame);
+		}
+		
+		Log("[%s %d] %s: entered in frame %d, lasted %s frames, calls took %d ms", phase_name, counter, key, phase.frame, duration, phase.time);
+	}
+	
+	for (var blocker in profile.blockers)
+	{
+		var held = "-";
+		if (blocker.released != nil)
+		{
+			held = Format("%d", blocker.released - blocker.registered);
+		}
+		Log("[%s %d] %s blocked %s for %s frames", phase_name, counter, blocker.name, blocker.phase, held);
+	}
+}
+
+
+/**
+ Gets the current phase.
+ @return string The key of the current phase.
+  */
+public func GetPhase()
+{
+	return GetPhaseKey(phase_index);
+}
+
+
+/**
+ Gets the number of the current cycle.
+ @return int The number of the current cycle. It starts counting at 1 and increases before the first phase is entered.
+  */
+public func GetPhaseCounter()
+{
+	return phase_counter;
+}
+
+
+/**
+ Use this to check if the cycle is in an active phase.
+ @return bool {@c true} if the current phase is marked as active.
+  */
+public func IsPhaseActive()
+{
+	return phase_counter > 0 && phase_list[phase_index].active;
+}
+
+
+/**
+ Callback from the parent manager, see {@link Library_PhaseManager#SetPhaseParent}.
+ @par key The phase that the parent entered.
+  */
+public func OnParentPhaseChanged(string key)
+{
+	if (key == phase_parent_key)
+	{
+		CheckPhaseTransition();
+	}
+	else if (phase_index != GetLength(phase_list) - 1)
+	{
+		// end the current cycle, regardless of the blockers
+		EnterPhase(GetLength(phase_list) - 1);
+	}
+}
+
+
+/**
+ Checks the next phase if it is due. Called by the scheduler.
+ @par frame The current frame.
+ @ignore
+  */
+public func ExecutePhaseSchedule(int frame)
+{
+	if (frame % PHASE_Sweep_Interval == 0)
+	{
+		SweepPhaseBlockers(GetPhaseKey(GetNextPhaseIndex()));
+	}
+
+	if (phase_due != nil && phase_due <= frame)
+	{
+		phase_due = nil;
+		CheckPhaseTransition();
+	}
+}
+
+
+public func AddPhaseChild(object child)
+{
+	if (!IsValueInArray(phase_children, child))
+	{
+		PushBack(phase_children, child);
+	}
+}
+
+
+public func RemovePhaseChild(object child)
+{
+	RemoveArrayValue(phase_children, child, false);
+}
+
+
+public func GetPhaseDepth()
+{
+	if (phase_parent == nil) return 0;
+
+	return phase_parent->GetPhaseDepth() + 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// internal functions
+
+/**
+ Checks if the object actually exists and throws an error if not.
+ @par blocker The blocker object.
+ @ignore
+  */
+private func CheckBlocker(object blocker)
+{
+	if (blocker == nil)
+	{
+		FatalError(Format("Must specify an existing object! Parameter is %v", blocker));
+	}
+}
+
+
+private func GetPhaseBlockers(string key)
+{
+	var blockers = GetProperty(key, phase_blockers);
+	if (blockers == nil)
+	{
+		blockers = {size = 0, entries = {}};
+		SetProperty(key, blockers, phase_blockers);
+	}
+	return blockers;
+}
+
+
+private func GetBlockerKey(object blocker)
+{
+	return Format("%d", blocker->ObjectNumber());
+}
+
+
+/**
+ Removes the blockers of a phase that were removed without telling the manager,
+ and enters the phase if nothing blocks it anymore.
+ @par key The phase.
+  */
+private func SweepPhaseBlockers(string key)
+{
+	var blockers = GetPhaseBlockers(key);
+	if (blockers.size == 0) return;
+
+	var swept = false;
+
+	for (var number in GetProperties(blockers.entries))
+	{
+		var entry = GetProperty(number, blockers.entries);
+		if (entry != nil && entry.blocker == nil)
+		{
+			DebugLog("Removed blocker %s from phase %s, because the object does not exist anymore", number, key);
+			SetProperty(number, nil, blockers.entries);
+			blockers.size--;
+			swept = true;
+			
+			if (phase_profiling) ProfileBlockerReleased(key, number);
+		}
+	}
+
+	if (swept)
+	{
+		CheckPhaseTransition();
+	}
+}
+
+
+private func GetPhaseIndex(string key)
+{
+	for (var i = 0; i < GetLength(phase_list); i++)
+	{
+		if (phase_list[i].key == key) return i;
+	}
+	return nil;
+}
+
+
+private func GetPhaseKey(int index)
+{
+	return phase_list[index].key;
+}
+
+
+private func GetNextPhaseIndex()
+{
+	return (phase_index + 1) % GetLength(phase_list);
+}
+
+
+private func CanEnterPhase(int index)
+{
+	// new cycles wait for the parent
+	if (index == 0 && phase_parent != nil && phase_parent->GetPhase() != phase_parent_key)
+	{
+		return false;
+	}
+
+	return GetPhaseBlockers(GetPhaseKey(index)).size == 0;
+}
+
+
+/**
+ Enters the next phase if nothing blocks it. If a phase is being entered right now,
+ then nothing happens: EnterPhase() always checks again after the game call of that phase,
+ so blockers that were removed during the call are taken into account there.
+  */
+private func CheckPhaseTransition()
+{
+	if (phase_busy) return;
+
+	var next = GetNextPhaseIndex();
+
+	// wait for the minimum duration, and start at most one cycle per frame
+	var ready = phase_entered + phase_list[phase_index].dwell;
+	if (next == 0)
+	{
+		ready = Max(ready, phase_cycle_frame + 1);
+	}
+
+	if (FrameCounter() < ready)
+	{
+		// several checks in the same frame end up as one
+		if (phase_due == nil || phase_due > ready)
+		{
+			phase_due = ready;
+		}
+		return;
+	}
+
+	if (CanEnterPhase(next))
+	{
+		EnterPhase(next);
+	}
+}
+
+
+/**
+ Enters a phase and issues its game call.
+  */
+private func EnterPhase(int index)
+{
+	phase_due = nil;
+	phase_index = index;
+	phase_entered = FrameCounter();
+
+	if (index == 0)
+	{
+		phase_counter++;
+		phase_cycle_frame = phase_entered;
+		
+		if (phase_profiling) ProfileCycleStarted();
+	}
+
+	var phase = phase_list[index];
+
+	phase_busy = true;
+
+	var time = GetTime();
+
+	if (phase.callback != nil)
+	{
+		IssuePhaseCall(phase.callback);
+	}
+	
+	if (phase_profiling) ProfilePhaseEntered(phase.key, GetTime() - time);
+
+	phase_busy = false;
+
+	for (var child in phase_children)
+	{
+		if (child) child->OnParentPhaseChanged(phase.key);
+	}
+
+	CheckPhaseTransition();
+}
+
+
+/**
+ Calls a function in the subscribers and in the scenario script.
+ The scenario script gets the call last, as with GameCallEx().
+  */
+private func IssuePhaseCall(string callback)
+{
+	var function = Format("~%s", callback);
+
+	for (var subscriber in GetPhaseSubscribers(phase_name))
+	{
+		// the object may have been removed by an earlier call
+		if (subscriber == nil) continue;
+
+		// these get the call from GameCallEx()
+		if (phase_broadcast && (subscriber->GetCategory() & (C4D_Goal | C4D_Rule | C4D_Environment))) continue;
+
+		subscriber->Call(function, phase_counter);
+	}
+
+	if (phase_broadcast)
+	{
+		GameCallEx(callback, phase_counter);
+	}
+	else
+	{
+		GameCall(callback, phase_counter);
+	}
+}
+
+
+/**
+ The next phase is checked after the given amount of frames.
+ Replaces a check that was scheduled earlier.
+  */
+private func SchedulePhaseCheck(int delay)
+{
+	phase_due = FrameCounter() + delay;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// profiling
+
+private func GetCurrentPhaseProfile()
+{
+	var profile;
+	if (GetLength(phase_profiles) > 0)
+	{
+		profile = phase_profiles[GetLength(phase_profiles) - 1];
+	}
+
+	if (profile == nil || profile.counter != phase_counter)
+	{
+		profile = {counter = phase_counter, phases = {}, blockers = []};
+		PushBack(phase_profiles, profile);
+
+		if (GetLength(phase_profiles) > PHASE_Profile_History)
+		{
+			phase_profiles = phase_profiles[1:];
+		}
+	}
+	return profile;
+}
+
+
+private func ProfileCycleStarted()
+{
+	if (phase_profile_log)
+	{
+		LogPhaseProfile(phase_counter - 1);
+	}
+
+	GetCurrentPhaseProfile();
+}
+
+
+private func ProfilePhaseEntered(string key, int time)
+{
+	SetProperty(key, {frame = phase_entered, time = time}, GetCurrentPhaseProfile().phases);
+}
+
+
+private func ProfileBlockerRegistered(string key, string number, object blocker)
+{
+	var record = {phase = key, name = Format("%s (%s)", blocker->GetName(), number), registered = FrameCounter()};
+
+	PushBack(GetCurrentPhaseProfile().blockers, record);
+	SetProperty(Format("%s_%s", key, number), record, phase_profile_open);
+}
+
+
+private func ProfileBlockerReleased(string key, string number)
+{
+	var open_key = Format("%s_%s", key, number);
+	var record = GetProperty(open_key, phase_profile_open);
+
+	if (record != nil)
+	{
+		record.released = FrameCounter();
+		SetProperty(open_key, nil, phase_profile_open);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// scheduler
+
+private func RegisterPhaseManager(object manager)
+{
+	if (phase_managers == nil)
+	{
+		phase_managers = [];
+	}
+
+	RemoveArrayValue(phase_managers, manager, false);
+
+	// insert after all managers with the same or lower depth
+	var depth = manager->GetPhaseDepth();
+	var position = GetLength(phase_managers);
+	while (position > 0 && (phase_managers[position - 1] == nil || phase_managers[position - 1]->GetPhaseDepth() > depth))
+	{
+		phase_managers[position] = phase_managers[position - 1];
+		position--;
+	}
+	phase_managers[position] = manager;
+
+	if (!GetEffect(PHASE_Scheduler_Effect))
+	{
+		AddEffect(PHASE_Scheduler_Effect, nil, 1, 1, nil, Library_PhaseManager);
+	}
+}
+
+
+private func FxIntPhaseSchedulerTimer(object target, proplist effect, int timer)
+{
+	var frame = FrameCounter();
+	var removed = false;
+
+	// copy, because managers may be registered while checking
+	for (var manager in phase_managers[:])
+	{
+		if (manager)
+		{
+			manager->ExecutePhaseSchedule(frame);
+		}
+		else
+		{
+			removed = true;
+		}
+	}
+
+	if (removed)
+	{
+		RemoveArrayValue(phase_managers, nil);
+	}
+	return FX_OK;
+}
@@ -1,27 +1,56 @@
 /**
  Dummy object. You can create this if you want to test the round system
- without having proper conditions for round end and start yet.
+ without having proper conditions for round end and start yet.@br
+ @br
+ The object can also play a number of short rounds and log how long they took,
+ see {@link RoundTester#TestRounds}.
  */
 
 local Name = "$Name$";
 local Description = "$Description$";
 
+local start_delay = 60;   // int: the round starts this many frames after the reset
+local end_delay = 360;    // int: the round ends this many frames after the start
+local test_first_round;   // int: the first round that is tested, or nil if no test is running
+local test_last_round;    // int: the last round that is tested
+
 public func Initialize()
 {
+	SubscribeRoundEvents(this);
 	return true;
 }
 
+
+/**
+ Plays a number of rounds and logs a timing summary afterwards.
+ The summary lists for every round the frames between reset, start and end,
+ how long the round calls took, and the longest time that a blocker held a phase.
+ @par rounds The number of rounds to test, counting from the next round.
+ @par round_start_delay The round starts this many frames after the reset.
+ @par round_end_delay The round ends this many frames after the start.
+  */
+public func TestRounds(int rounds, int round_start_delay, int round_end_delay)
+{
+	start_delay = Max(1, round_start_delay);
+	end_delay = Max(1, round_end_delay);
+	
+	test_first_round = RoundManager()->GetRoundNumber() + 1;
+	test_last_round = test_first_round + Max(1, rounds) - 1;
+	
+	RoundManager()->SetPhaseProfiling(true);
+}
+
 public func OnRoundReset(int counter)
 {
 	DebugLog("[%d] RoundHelper preparing for round %d", FrameCounter(), counter);
 	RoundManager()->RegisterRoundStartBlocker(this);
 	
-	ScheduleCall(this, "TriggerRoundStart", 60, 0);
+	ScheduleCall(this, "TriggerRoundStart", start_delay, 0);
 }
 
 public func TriggerRoundStart()
 {
-	DebugLog("[%d] +60 Removing myself from the blocker list", FrameCounter());
+	DebugLog("[%d] +%d Removing myself from the blocker list", FrameCounter(), start_delay);
 	RoundManager()->RemoveRoundStartBlocker(this);
 }
 
@@ -29,16 +58,67 @@ public func OnRoundStart(int counter)
 {
 	DebugLog("[%d] RoundHelper: Round %d starts", FrameCounter(), counter);
 	RoundManager()->RegisterRoundEndBlocker(this);
-	ScheduleCall(this, "TriggerRoundEnd", 36*10, 0);
+	ScheduleCall(this, "TriggerRoundEnd", end_delay, 0);
 }
 
 public func TriggerRoundEnd()
 {
-	DebugLog("[%d] + 360 RoundHelper: stop the round", FrameCounter());
+	DebugLog("[%d] +%d RoundHelper: stop the round", FrameCounter(), end_delay);
 	RoundManager()->RemoveRoundEndBlocker(this);
 }
 
 public func OnRoundEnd(int counter)
 {
 	DebugLog("[%d] RoundHelper: Round %d ends", FrameCounter(), counter);
-}
\ No newline at end of file
+	
+	if (test_first_round != nil && counter >= test_last_round)
+	{
+		// the round end is recorded after all objects got the call
+		ScheduleCall(this, "LogTestSummary", 1, 0);
+	}
+}
+
+public func LogTestSummary()
+{
+	var rounds = 0;
+	var total_waiting = 0;
+	var total_playing = 0;
+	var total_time = 0;
+	
+	for (var round = test_first_round; round <= test_last_round; round++)
+	{
+		var profile = RoundManager()->GetRoundProfile(round);
+		if (profile == nil) continue;
+		
+		var waiting = profile.phases.start.frame - profile.phases.reset.frame;
+		var playing = profile.phases.end.frame - profile.phases.start.frame;
+		var time = profile.phases.reset.time + profile.phases.start.time + profile.phases.end.time;
+		
+		var longest_hold = 0;
+		for (var blocker in profile.blockers)
+		{
+			if (blocker.released != nil)
+			{
+				longest_hold = Max(longest_hold, blocker.released - blocker.registered);
+			}
+		}
+		
+		Log("Round %d: reset to start %d frames, start to end %d frames, calls %d ms, %d blockers held up to %d frames", round, waiting, playing, time, GetLength(profile.blockers), longest_hold);
+		
+		rounds++;
+		total_waiting += waiting;
+		total_playing += playing;
+		total_time += time;
+	}
+	
+	if (rounds > 0)
+	{
+		Log("Average of %d rounds: reset to start %d frames, start to end %d frames, calls %d ms", rounds, total_waiting / rounds, total_playing / rounds, total_time / rounds);
+	}
+	
+	test_first_round = nil;
+	test_last_round = nil;
+	start_delay = 60;
+	end_delay = 360;
+	RoundManager()->SetPhaseProfiling(false);
+}
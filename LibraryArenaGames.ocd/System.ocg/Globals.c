@@ -5,5 +5,213 @@
   */
 global func GameConfiguration()
 {
-	return FindObject(Find_Func("IsGameConfiguration"));
+	return GetEnvironmentSingleton("GameConfiguration") ?? FindEnvironmentSingleton("GameConfiguration", Find_Func("IsGameConfiguration"));
+}
+
+
+static environment_singletons;       // proplist: name to object, see RegisterEnvironmentSingleton()
+static environment_singleton_misses; // proplist: name to true, if FindEnvironmentSingleton() found nothing since the last registration
+
+/**
+ Remembers an object that exists only once, such as the round manager, so that
+ it can be accessed without searching for it. Objects should register in {@c Initialize()}
+ and unregister in {@c Destruction()}.
+ @note Objects that do not register may not be found: Once the search for a name
+       found nothing, it is repeated only after an object registered with that name.
+ @par name The name of the object, for example {@c "RoundManager"}.
+ @par singleton The object.
+  */
+global func RegisterEnvironmentSingleton(string name, object singleton)
+{
+	if (environment_singletons == nil)
+	{
+		environment_singletons = {};
+	}
+	SetProperty(name, singleton, environment_singletons);
+	
+	if (environment_singleton_misses != nil)
+	{
+		SetProperty(name, nil, environment_singleton_misses);
+	}
+}
+
+/**
+ Forgets an object that was registered with {@link Global#RegisterEnvironmentSingleton}.
+ @par name The name of the object.
+ @par singleton The object. Nothing happens if another object is registered with that name.
+  */
+global func UnregisterEnvironmentSingleton(string name, object singleton)
+{
+	if (environment_singletons != nil && GetProperty(name, environment_singletons) == singleton)
+	{
+		SetProperty(name, nil, environment_singletons);
+	}
+}
+
+/**
+ Gets an object that was registered with {@link Global#RegisterEnvironmentSingleton}.
+ @par name The name of the object.
+ @return object The object, or {@c nil} if no object is registered.
+  */
+global func GetEnvironmentSingleton(string name)
+{
+	if (environment_singletons == nil) return nil;
+
+	return GetProperty(name, environment_singletons);
+}
+
+/**
+ Searches for an object that was not registered, for example because it was
+ loaded from a savegame, and registers it.
+ If nothing is found, then this is remembered, and further calls do not search
+ again until an object is registered with that name.
+ @par name The name of the object.
+ @par criteria The search criteria for {@c FindObject()}.
+ @return object The object, or {@c nil} if it does not exist.
+  */
+global func FindEnvironmentSingleton(string name, array criteria)
+{
+	if (environment_singleton_misses == nil)
+	{
+		environment_singleton_misses = {};
+	}
+	else if (GetProperty(name, environment_singleton_misses))
+	{
+		return nil;
+	}
+
+	var singleton = FindObject(criteria);
+	if (singleton)
+	{
+		RegisterEnvironmentSingleton(name, singleton);
+	}
+	else
+	{
+		SetProperty(name, true, environment_singleton_misses);
+	}
+	return singleton;
+}
+
+
+static phase_subscriptions; // proplist: name of a phase manager to its subscribers, see SubscribePhaseEvents(); consists of:
+                            // * list - array: entries in the order in which they are called, an entry consists of:
+                            //   * subscriber - object: gets the callbacks
+                            //   * priority - int: subscribers with a higher priority are called first
+                            // * known - proplist: object number to the entry of that object
+                            // * dirty - bool: the list contains entries that were unsubscribed
+
+/**
+ Lets an object receive the game calls of a phase manager, such as {@c OnRoundStart()} from the
+ {@link Environment_RoundManager#index round manager}. Only subscribed objects and the scenario
+ script get these calls. Subscribing again changes the priority.
+ @par name The name of the manager, for example {@c "RoundManager"}.
+ @par subscriber The object.
+ @par priority Objects with a higher priority get the calls first. Objects with
+               the same priority get the calls in the order in which they subscribed.
+  */
+global func SubscribePhaseEvents(string name, object subscriber, int priority)
+{
+	if (subscriber == nil)
+	{
+		FatalError(Format("Must specify an existing object! Parameter is %v", subscriber));
+	}
+
+	var subscriptions = GetPhaseSubscriptions(name);
+	var number = Format("%d", subscriber->ObjectNumber());
+	var entry = GetProperty(number, subscriptions.known);
+
+	if (entry != nil)
+	{
+		if (entry.priority == priority) return;
+
+		UnsubscribePhaseEvents(name, subscriber);
+	}
+
+	entry = {subscriber = subscriber, priority = priority};
+	SetProperty(number, entry, subscriptions.known);
+
+	// sorted by priority; appending is the usual case
+	var list = subscriptions.list;
+	var position = GetLength(list);
+	while (position > 0 && list[position - 1].priority < priority)
+	{
+		list[position] = list[position - 1];
+		position--;
+	}
+	list[position] = entry;
+}
+
+/**
+ Stops an object from receiving the game calls of a phase manager, see {@link Global#SubscribePhaseEvents}.
+ Objects that are removed are unsubscribed automatically.
+ @par name The name of the manager.
+ @par subscriber The object.
+  */
+global func UnsubscribePhaseEvents(string name, object subscriber)
+{
+	var subscriptions = GetPhaseSubscriptions(name);
+	var number = Format("%d", subscriber->ObjectNumber());
+	var entry = GetProperty(number, subscriptions.known);
+
+	if (entry != nil)
+	{
+		entry.subscriber = nil;
+		SetProperty(number, nil, subscriptions.known);
+		subscriptions.dirty = true;
+	}
+}
+
+/**
+ Gets the objects that receive the game calls of a phase manager.
+ @par name The name of the manager.
+ @return array The subscribers, in the order in which they get the calls.
+  */
+global func GetPhaseSubscribers(string name)
+{
+	var subscriptions = GetPhaseSubscriptions(name);
+
+	// removed objects are nil in the entries
+	var list = [];
+	for (var entry in subscriptions.list)
+	{
+		if (entry.subscriber != nil)
+		{
+			PushBack(list, entry);
+		}
+	}
+
+	if (subscriptions.dirty || GetLength(list) != GetLength(subscriptions.list))
+	{
+		subscriptions.list = list;
+		subscriptions.known = {};
+		subscriptions.dirty = false;
+
+		for (var entry in list)
+		{
+			SetProperty(Format("%d", entry.subscriber->ObjectNumber()), entry, subscriptions.known);
+		}
+	}
+
+	var subscribers = [];
+	for (var entry in list)
+	{
+		PushBack(subscribers, entry.subscriber);
+	}
+	return subscribers;
+}
+
+global func GetPhaseSubscriptions(string name)
+{
+	if (phase_subscriptions == nil)
+	{
+		phase_subscriptions = {};
+	}
+
+	var subscriptions = GetProperty(name, phase_subscriptions);
+	if (subscriptions == nil)
+	{
+		subscriptions = {list = [], known = {}, dirty = false};
+		SetProperty(name, subscriptions, phase_subscriptions);
+	}
+	return subscriptions;
 }
@@ -6,6 +6,12 @@
   */
 global func AddMenuItem(string caption, string command, id symbol, int count, parameter, string info_caption, int extra, XPar1, XPar2)
 {
+	// the menu is being recorded, see RecordMenuItems()
+	if (GetType(this) == C4V_C4Object && this.menu_recording != nil)
+	{
+		PushBack(this.menu_recording, [caption, command, symbol, count, parameter, info_caption, extra, XPar1, XPar2]);
+		return true;
+	}
 	
 	//DebugLog(Format("AddMenuItem %s %s", Format("caption: %v, command: %v, symbol: %v, count: %v, parameter: %v", caption, command, symbol, count, parameter), Format(", caption: %v, extra: %v, xpar1: %v, xpar2: %v", info_caption, extra, XPar1, XPar2)));
 	var extraX = extra;
@@ -21,6 +27,55 @@ global func AddMenuItem(string caption, string command, id symbol, int count, pa
 	return _inherited(caption, command, symbol, count, parameter, info_caption, extraX, XPar1X, XPar2);
 }
 
+/**
+ Records the menu items that are added to the object's menu, instead of adding them.
+ The items can be added later with {@link Global#AddRecordedMenuItems}. This way a
+ menu can be compared with its previous state before it is displayed.
+ @return array The items will be added to this array. Each item is an array of the parameters for {@c AddMenuItem()}.
+  */
+global func RecordMenuItems()
+{
+	if (GetType(this) != C4V_C4Object)
+	{
+		FatalError("This function must be called from object context.");
+	}
+	
+	this.menu_recording = [];
+	return this.menu_recording;
+}
+
+
+/**
+ Stops recording menu items, see {@link Global#RecordMenuItems}.
+ @return array The recorded items.
+  */
+global func StopRecordingMenuItems()
+{
+	var items = this.menu_recording;
+	this.menu_recording = nil;
+	return items;
+}
+
+
+/**
+ Adds menu items that were recorded with {@link Global#RecordMenuItems} to the object's menu.
+ @par items The recorded items.
+ @par icon_holder The icon dummies for the items count as used by this object, see {@link Global#AcquireIconDummy}.
+                  By default, they count as used by the object that has the menu.
+  */
+global func AddRecordedMenuItems(array items, object icon_holder)
+{
+	this.menu_icon_holder = icon_holder;
+
+	for (var item in items)
+	{
+		AddMenuItem(item[0], item[1], item[2], item[3], item[4], item[5], item[6], item[7], item[8]);
+	}
+	
+	this.menu_icon_holder = nil;
+}
+
+
 /**
  @author Marky
   */
@@ -31,6 +86,13 @@ global func HasMeshGraphics()
 }
 
 
+/**
+ Gets a dummy object that displays a mesh definition in a menu.
+ The dummy is shared, see {@link Global#AcquireIconDummy}; the calling object counts as its holder,
+ unless {@link Global#AddRecordedMenuItems} specifies another holder.
+ @par type The definition.
+ @return object The dummy, or {@c nil} if the definition has no mesh graphics.
+  */
 global func GetMeshDummy(id type)
 {
 	if (GetType(this) != C4V_C4Object)
@@ -38,26 +100,110 @@ global func GetMeshDummy(id type)
 		FatalError("This function must be called from object context.");
 	}
 	
-	var name = Format("%v", type);
-	
 	if (!(type->HasMeshGraphics()))
 	{
 		return nil;
 	}
 
-	var dummy = GetProperty(name, this.proplist_addmenuitem);
-	if (!dummy)
+	return AcquireIconDummy(type, nil, this.menu_icon_holder ?? this);
+}
+
+
+static icon_dummies; // proplist: key to the icon dummy, see AcquireIconDummy(); an entry consists of:
+                     // * dummy - object: displays the icon
+                     // * holders - array: the objects that use the dummy; the dummy is removed when there are none left
+
+/**
+ Gets a dummy object that displays the picture of a definition, for menu items that
+ need an object as icon. Dummies are created when they are needed first and shared
+ between all menus. They are counted by holder, so that they can be removed with
+ {@link Global#ReleaseIconDummies} once nobody needs them anymore.
+ @par type The dummy displays the picture of this definition.
+ @par color The dummy has this color modulation. Pass {@c nil} for no color modulation.
+ @par holder This object uses the dummy, usually the object that opens the menu.
+ @return object The dummy.
+  */
+global func AcquireIconDummy(id type, int color, object holder)
+{
+	if (type == nil || holder == nil)
+	{
+		FatalError(Format("Must specify a definition and an existing holder, got %v and %v", type, holder));
+	}
+
+	if (icon_dummies == nil)
+	{
+		icon_dummies = {};
+	}
+
+	var key = Format("%i_%v", type, color);
+	var entry = GetProperty(key, icon_dummies);
+	
+	if (entry == nil)
 	{
-		dummy = CreateObject(Dummy, -GetX(), -GetY(), NO_OWNER);
-		dummy->SetGraphics(nil, Dummy, 0, GFXOV_MODE_None);
-		dummy->SetGraphics(nil, type, 1, GFXOV_MODE_Picture);
+		entry = {holders = []};
+		SetProperty(key, entry, icon_dummies);
+	}
+	
+	if (entry.dummy == nil)
+	{
+		entry.dummy = CreateObject(Dummy, 0, 0, NO_OWNER);
+		entry.dummy->SetPosition(0, 0);
 		
-		if (!SetProperty(name, dummy, this.proplist_addmenuitem))
+		// overlay 0 replaces the base graphics and would display the mesh, so meshes
+		// get an invisible base and their picture in an overlay instead
+		var overlay = 0;
+		if (type->HasMeshGraphics())
 		{
-			this.proplist_addmenuitem = {"Dummy" = nil};
-			SetProperty(name, dummy, this.proplist_addmenuitem);
+			overlay = 1;
+			entry.dummy->SetGraphics(nil, Dummy, 0, GFXOV_MODE_None);
+		}
+		
+		entry.dummy->SetGraphics(nil, type, overlay, GFXOV_MODE_Picture);
+		
+		if (color != nil)
+		{
+			entry.dummy->SetClrModulation(color, overlay);
 		}
 	}
 	
-	return dummy;
+	if (!IsValueInArray(entry.holders, holder))
+	{
+		PushBack(entry.holders, holder);
+	}
+
+	return entry.dummy;
+}
+
+
+/**
+ Releases all dummies that an object got from {@link Global#AcquireIconDummy}.
+ Dummies that have no holders left are removed.
+ @par holder The object that used the dummies.
+  */
+global func ReleaseIconDummies(object holder)
+{
+	if (icon_dummies == nil) return;
+
+	for (var key in GetProperties(icon_dummies))
+	{
+		var entry = GetProperty(key, icon_dummies);
+		if (entry == nil) continue;
+		
+		// holders that were removed do not count anymore
+		var holders = [];
+		for (var other in entry.holders)
+		{
+			if (other != nil && other != holder)
+			{
+				PushBack(holders, other);
+			}
+		}
+		entry.holders = holders;
+		
+		if (GetLength(holders) == 0)
+		{
+			if (entry.dummy) entry.dummy->RemoveObject();
+			SetProperty(key, nil, icon_dummies);
+		}
+	}
 }
@@ -26,26 +26,12 @@ protected func Initialize()
 	
 	template_flint->RemoveObject();
 	
-	var template_grass = CreateSpawnPoint(0, 0)->SetRespawnTimer(SPAWNPOINT_Timer_Infinite)->SpawnDeco(Grass);
-
-	CopySpawnPoint(template_grass, 365, 346);
-	CopySpawnPoint(template_grass, 370, 346);
-	CopySpawnPoint(template_grass, 375, 346);
-	CopySpawnPoint(template_grass, 380, 346);
-	CopySpawnPoint(template_grass, 385, 346);
-	CopySpawnPoint(template_grass, 390, 346);
-	CopySpawnPoint(template_grass, 395, 346);
-	CopySpawnPoint(template_grass, 400, 346);
-
-	CopySpawnPoint(template_grass, 200, 123);
-	CopySpawnPoint(template_grass, 245, 130);
-	CopySpawnPoint(template_grass, 255, 130);
-
-	CopySpawnPoint(template_grass, 385, 103);
-	CopySpawnPoint(template_grass, 415,  81);
-	CopySpawnPoint(template_grass, 465,  65);
-	
-	template_grass->RemoveObject();
+	AddDecoSpawns(Grass,
+	[
+		[365, 346], [370, 346], [375, 346], [380, 346], [385, 346], [390, 346], [395, 346], [400, 346],
+		[200, 123], [245, 130], [255, 130],
+		[385, 103], [415,  81], [465,  65]
+	]);
 
 	
 	CreateObject(Environment_RoundManager);
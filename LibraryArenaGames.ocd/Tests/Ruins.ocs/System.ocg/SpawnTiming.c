@@ -0,0 +1,148 @@
+/**
+ Checks that the spawn points spawn in the same frames as the spawn point did
+ before it was driven by the spawn point scheduler.@br
+ @br
+ The reference is the countdown of the old spawn point: Every spawn point and the deco registry
+ run a copy of it, see SpawnTimingTick(). The copy gets the same collections and removals as the
+ actual spawn point, so the reference is exact even though the spawn times depend on the players.
+ A spawn that does not happen in the same frame as in the copy is logged as an error, with a line
+ that starts with "SpawnTiming ERROR". At the end of every round the number of checked spawns
+ and errors is logged.@br
+ @br
+ The copy counts by player slot, while the old spawn point counted by player index. The indices
+ changed when a player left the game, so the check is exact only as long as no player leaves.
+ */
+
+static spawn_timing_checked; // int: the number of spawns that were compared
+static spawn_timing_errors;  // int: the number of spawns that differ from the reference
+
+/**
+ Creates the state of the old countdown for one object of a spawn point.
+ The state consists of:@br
+ - timer - int: the countdown, same as {@c spawn_timer} in the old spawn point@br
+ - present - bool: the object existed after the last tick@br
+ - events - array: the frames where the object appeared or disappeared since the last tick
+ */
+global func SpawnTimingCreateState()
+{
+	return {timer = nil, present = false, events = []};
+}
+
+
+/**
+ Tells the reference whether the spawn point has the object now.
+ */
+global func SpawnTimingTrack(proplist state, bool has_object)
+{
+	var last = state.present;
+	if (GetLength(state.events) > 0)
+	{
+		last = state.events[GetLength(state.events) - 1].spawned;
+	}
+
+	if (has_object != last)
+	{
+		PushBack(state.events, {frame = FrameCounter(), spawned = has_object});
+	}
+}
+
+
+/**
+ Runs one tick of the old countdown, see DecreaseTimer() in the old spawn point,
+ and compares it with the spawns of the actual spawn point in that frame.
+ The tick must be in the past, so that all spawns of that frame are known.
+ @par state The state, see SpawnTimingCreateState().
+ @par tick The frame of the tick.
+ @par origin The round started in this frame.
+ @par timer_interval The respawn timer of the spawn point.
+ @par name Describes the object in the log.
+ */
+global func SpawnTimingTick(proplist state, int tick, int origin, int timer_interval, string name)
+{
+	var present = state.present;
+	var spawned = false;
+	var present_after = nil;
+	var remaining = [];
+
+	for (var event in state.events)
+	{
+		if (event.frame < tick)
+		{
+			// the old spawn point spawned only on ticks
+			if (event.spawned)
+			{
+				SpawnTimingError(name, Format("spawned in frame +%d, which is not a spawn tick", event.frame - origin));
+			}
+			present = event.spawned;
+		}
+		else if (event.frame == tick)
+		{
+			spawned = spawned || event.spawned;
+			present_after = event.spawned;
+		}
+		else
+		{
+			PushBack(remaining, event);
+		}
+	}
+
+	// the old countdown
+	var expected = false;
+	if (!present)
+	{
+		if (state.timer <= 0)
+		{
+			expected = true;
+			state.timer = timer_interval;
+		}
+
+		if (timer_interval != SPAWNPOINT_Timer_Infinite)
+		{
+			state.timer -= SpawnPoint->SpawnPointEffectInterval();
+		}
+	}
+
+	if (expected)
+	{
+		spawn_timing_checked++;
+	}
+
+	if (expected && !spawned)
+	{
+		SpawnTimingError(name, Format("should have spawned in frame +%d", tick - origin));
+	}
+	else if (!expected && spawned)
+	{
+		SpawnTimingError(name, Format("spawned in frame +%d, but should not have spawned", tick - origin));
+	}
+
+	state.present = present_after ?? present;
+	state.events = remaining;
+}
+
+
+global func SpawnTimingError(string name, string message)
+{
+	spawn_timing_errors++;
+	Log("SpawnTiming ERROR: %s %s", name, message);
+}
+
+
+/**
+ Logs the number of checked spawns and errors, once per round.
+ */
+global func SpawnTimingRoundEnd()
+{
+	// the other spawn points compare their last ticks in this frame, too
+	if (!GetEffect("IntSpawnTimingSummary"))
+	{
+		AddEffect("IntSpawnTimingSummary", nil, 1, 1);
+	}
+}
+
+
+global func FxIntSpawnTimingSummaryTimer()
+{
+	Log("SpawnTiming: %d spawns compared with the old spawn point, %d errors", spawn_timing_checked, spawn_timing_errors);
+	return FX_Execute_Kill;
+}
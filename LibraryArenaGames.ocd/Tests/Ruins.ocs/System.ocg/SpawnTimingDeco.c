@@ -0,0 +1,93 @@
+/**
+ Compares the spawn timing of the deco registry with the old countdown, see SpawnTiming.c.
+ The decoration in this scenario used spawn points with SPAWNPOINT_Timer_Infinite before.
+ */
+
+#appendto Arena_SpawnPointDeco
+
+local timing_states; // array map: record index to the state of the old countdown
+local timing_origin; // int: the round started in this frame
+local timing_tick;   // int: the next tick that is compared, or nil while the round is not running
+
+public func OnRoundStart()
+{
+	var result = _inherited(...);
+
+	// every record had its own spawn point, and the countdown of these never changes
+	timing_states = [];
+	for (var index = 0; index < GetLength(deco_records); index++)
+	{
+		timing_states[index] = SpawnTimingCreateState();
+	}
+
+	timing_origin = FrameCounter();
+	timing_tick = timing_origin + SpawnPoint->SpawnPointEffectInterval();
+
+	if (!GetEffect("IntSpawnTiming", this))
+	{
+		AddEffect("IntSpawnTiming", this, 1, 1, this);
+	}
+	return result;
+}
+
+
+public func OnRoundEnd()
+{
+	ExecuteTimingTicks();
+	timing_tick = nil;
+	SpawnTimingRoundEnd();
+
+	return _inherited(...);
+}
+
+
+public func OnSpawnSchedulerCall(int index, int due)
+{
+	var result = _inherited(index, due, ...);
+	TrackTiming();
+	return result;
+}
+
+
+private func FxIntDecoWatchStop(object target, proplist effect, int reason, bool temp)
+{
+	var result = _inherited(target, effect, reason, temp, ...);
+	TrackTiming();
+	return result;
+}
+
+
+private func FxIntSpawnTimingTimer()
+{
+	ExecuteTimingTicks();
+	return FX_OK;
+}
+
+
+private func TrackTiming()
+{
+	if (timing_tick == nil) return;
+
+	for (var index = 0; index < GetLength(timing_states); index++)
+	{
+		SpawnTimingTrack(timing_states[index], deco_objects[index] != nil);
+	}
+}
+
+
+private func ExecuteTimingTicks()
+{
+	if (timing_tick == nil) return;
+
+	// compare only ticks in the past, so that all spawns of that frame are known
+	while (timing_tick < FrameCounter())
+	{
+		for (var index = 0; index < GetLength(timing_states); index++)
+		{
+			var record = deco_records[index];
+			var name = Format("%i at (%d, %d)", record.id, record.x, record.y);
+			SpawnTimingTick(timing_states[index], timing_tick, timing_origin, SPAWNPOINT_Timer_Infinite, name);
+		}
+		timing_tick += SpawnPoint->SpawnPointEffectInterval();
+	}
+}
@@ -0,0 +1,135 @@
+/**
+ Compares the spawn timing of the spawn points with the old countdown, see SpawnTiming.c.
+ Shared spawn points and exact timers did not exist before and are not checked.
+ */
+
+#appendto SpawnPoint
+
+local timing_states; // array map: player slot to the state of the old countdown
+local timing_origin; // int: the round started in this frame
+local timing_tick;   // int: the next tick that is compared, or nil while the spawn point does not spawn
+
+public func OnRoundStart()
+{
+	var result = _inherited(...);
+
+	// the objects of the last round were removed, but the countdown continues
+	timing_states = timing_states ?? [];
+	for (var slot = 0; slot < GetLength(timing_states); slot++)
+	{
+		if (timing_states[slot] != nil)
+		{
+			timing_states[slot].present = false;
+			timing_states[slot].events = [];
+		}
+	}
+
+	timing_origin = FrameCounter();
+	timing_tick = timing_origin + SpawnPointEffectInterval();
+
+	if (!GetEffect("IntSpawnTiming", this))
+	{
+		AddEffect("IntSpawnTiming", this, 1, 1, this);
+	}
+	return result;
+}
+
+
+public func OnRoundEnd()
+{
+	ExecuteTimingTicks();
+	timing_tick = nil;
+	SpawnTimingRoundEnd();
+
+	return _inherited(...);
+}
+
+
+public func EffectSpawn(int index)
+{
+	TrackTiming();
+	return _inherited(index, ...);
+}
+
+
+private func DoCollectObject(int index, object clonk)
+{
+	var result = _inherited(index, clonk, ...);
+	TrackTiming();
+	return result;
+}
+
+
+private func FxIntSpawnWatchStop(object target, proplist effect, int reason, bool temp)
+{
+	var result = _inherited(target, effect, reason, temp, ...);
+	TrackTiming();
+	return result;
+}
+
+
+private func FxIntSpawnTimingTimer()
+{
+	ExecuteTimingTicks();
+	return FX_OK;
+}
+
+
+private func IsTimingChecked()
+{
+	return timing_tick != nil && timing_states != nil && !IsShared() && !spawn_exact;
+}
+
+
+private func GetTimingSlots()
+{
+	if (spawn_globally) return [0];
+
+	var slots = [];
+	for (var slot = 0; slot < GetLength(slot_player); slot++)
+	{
+		if (slot_player[slot] != nil) PushBack(slots, slot);
+	}
+	return slots;
+}
+
+
+private func GetTimingState(int slot)
+{
+	if (timing_states[slot] == nil)
+	{
+		timing_states[slot] = SpawnTimingCreateState();
+	}
+	return timing_states[slot];
+}
+
+
+private func TrackTiming()
+{
+	if (!IsTimingChecked()) return;
+
+	for (var slot in GetTimingSlots())
+	{
+		SpawnTimingTrack(GetTimingState(slot), HasObject(slot));
+	}
+}
+
+
+private func ExecuteTimingTicks()
+{
+	if (!IsTimingChecked()) return;
+
+	// compare only ticks in the past, so that all spawns of that frame are known
+	while (timing_tick < FrameCounter())
+	{
+		if (is_active)
+		{
+			for (var slot in GetTimingSlots())
+			{
+				var name = Format("%i at (%d, %d), slot %d,", spawn_id, GetX(), GetY(), slot);
+				SpawnTimingTick(GetTimingState(slot), timing_tick, timing_origin, timer_interval, name);
+			}
+		}
+		timing_tick += SpawnPointEffectInterval();
+	}
+}
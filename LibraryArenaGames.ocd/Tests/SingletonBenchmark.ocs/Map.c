@@ -0,0 +1,9 @@
+/**
+ Flat ground, so that the rocks lie on the surface and do not fall for the whole benchmark.
+ */
+
+protected func InitializeMap(proplist map)
+{
+	map->Draw("Earth", nil, [0, map.Hgt / 2, map.Wdt, map.Hgt / 2]);
+	return true;
+}
@@ -0,0 +1,81 @@
+/**
+ Benchmark for the lookup of environment objects.
+ 
+ Creates many objects and looks up the game configuration, the round manager and the
+ turn manager many times per frame: first by searching the objects, as the lookup functions
+ did before, then with the lookup functions, which use the registered objects. The script time
+ per frame is written to the log.
+ 
+ Run it headless, for example: openclonk --headless LibraryArenaGames.ocd/Tests/SingletonBenchmark.ocs
+ 
+ @author Marky
+*/
+
+static const BENCHMARK_Objects = 1000;
+static const BENCHMARK_Calls = 100;   // lookups of each object per frame
+static const BENCHMARK_Frames = 100;  // frames per mode
+
+protected func Initialize()
+{
+	for (var i = 0; i < BENCHMARK_Objects; i++)
+	{
+		CreateObject(Rock, 10 + Random(LandscapeWidth() - 20), LandscapeHeight() / 2 - 10, NO_OWNER);
+	}
+	
+	CreateObject(Environment_RoundManager);
+	CreateObject(Environment_TurnManager);
+	CreateObject(Environment_Configuration);
+
+	AddEffect("Benchmark", nil, 1, 1);
+}
+
+
+global func FxBenchmarkStart(object target, proplist effect, int temp)
+{
+	if (temp) return;
+
+	effect.search_time = 0;
+	effect.registry_time = 0;
+}
+
+
+global func FxBenchmarkTimer(object target, proplist effect, int time)
+{
+	if (time <= BENCHMARK_Frames)
+	{
+		var start = GetTime();
+		for (var i = 0; i < BENCHMARK_Calls; i++)
+		{
+			FindObject(Find_Func("IsGameConfiguration"));
+			FindObject(Find_ID(Environment_RoundManager));
+			FindObject(Find_ID(Environment_TurnManager));
+		}
+		effect.search_time += GetTime() - start;
+	}
+	else if (time <= 2 * BENCHMARK_Frames)
+	{
+		var start = GetTime();
+		for (var i = 0; i < BENCHMARK_Calls; i++)
+		{
+			GameConfiguration();
+			RoundManager();
+			TurnManager();
+		}
+		effect.registry_time += GetTime() - start;
+	}
+	else
+	{
+		LogBenchmarkResult("search", effect.search_time);
+		LogBenchmarkResult("registry", effect.registry_time);
+		GameOver();
+		return FX_Execute_Kill;
+	}
+	return FX_OK;
+}
+
+
+global func LogBenchmarkResult(string mode, int milliseconds)
+{
+	var microseconds = milliseconds * 1000 / BENCHMARK_Frames;
+	Log("Benchmark: %d objects, %d lookups of each object per frame, %s: %d.%03d ms per frame", BENCHMARK_Objects, BENCHMARK_Calls, mode, microseconds / 1000, microseconds % 1000);
+}
@@ -0,0 +1,9 @@
+/**
+ Flat ground, so that the bots can walk over all spawn points.
+ */
+
+protected func InitializeMap(proplist map)
+{
+	map->Draw("Earth", nil, [0, map.Hgt / 2, map.Wdt, map.Hgt / 2]);
+	return true;
+}
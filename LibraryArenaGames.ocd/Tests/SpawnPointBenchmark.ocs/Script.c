@@ -0,0 +1,121 @@
+/**
+ Benchmark for collection from spawn points.
+ 
+ Creates many collectible spawn points and bots that walk over them. The collection
+ is measured twice: first every spawn point searches for crew members on its own, then
+ the spawn point scheduler handles collection with its grid. The script time that is spent
+ for collection is written to the log, as average per frame.
+ 
+ Run it headless, for example: openclonk --headless LibraryArenaGames.ocd/Tests/SpawnPointBenchmark.ocs
+ 
+ @author Marky
+*/
+
+static const BENCHMARK_SpawnPoints = 500;
+static const BENCHMARK_Bots = 24;
+static const BENCHMARK_Warmup = 100;  // frames
+static const BENCHMARK_Frames = 1000; // frames
+
+static benchmark_legacy_collection; // bool: spawn points use their own collection effect
+static benchmark_collection_time;   // int: milliseconds spent in collection
+
+protected func Initialize()
+{
+	var ground = LandscapeHeight() / 2;
+
+	var template = CreateSpawnPoint(0, 0)->SetRespawnTimer(FRAME_Per_Second)->SpawnItem(Rock);
+	for (var i = 0; i < BENCHMARK_SpawnPoints; i++)
+	{
+		CopySpawnPoint(template, 10 + Random(LandscapeWidth() - 20), ground - 10);
+	}
+	template->RemoveObject();
+	
+	for (var i = 0; i < BENCHMARK_Bots; i++)
+	{
+		CreateScriptPlayer(Format("Bot %d", i + 1), HSL(Random(16) * 16, 255, 127));
+	}
+	
+	AddEffect("Benchmark", nil, 1, 1);
+}
+
+
+protected func InitializePlayer(int player)
+{
+	var clonk = CreateObject(Clonk, 10 + Random(LandscapeWidth() - 20), LandscapeHeight() / 2 - 10, player);
+	clonk->MakeCrewMember(player);
+	SetCursor(player, clonk);
+	
+	// walk around all the time
+	AddEffect("BenchmarkWalk", clonk, 1, 40);
+}
+
+
+global func FxBenchmarkWalkTimer(object target, proplist effect, int time)
+{
+	if (target->GetX() < 20 || (target->GetComDir() != COMD_Left && target->GetX() < LandscapeWidth() - 20 && !Random(4)))
+	{
+		target->SetComDir(COMD_Right);
+	}
+	else
+	{
+		target->SetComDir(COMD_Left);
+	}
+}
+
+
+global func FxBenchmarkStart(object target, proplist effect, int temp)
+{
+	if (temp) return;
+
+	effect.phases = [true, false];
+	effect.results = [];
+	effect.phase = 0;
+	effect.phase_start = 0;
+	StartBenchmarkPhase(effect);
+}
+
+
+global func FxBenchmarkTimer(object target, proplist effect, int time)
+{
+	var frames = time - effect.phase_start;
+
+	if (frames == BENCHMARK_Warmup)
+	{
+		benchmark_collection_time = 0;
+	}
+	else if (frames == BENCHMARK_Warmup + BENCHMARK_Frames)
+	{
+		PushBack(effect.results, benchmark_collection_time);
+		GameCallEx("OnRoundEnd", effect.phase + 1);
+
+		effect.phase++;
+		if (effect.phase < GetLength(effect.phases))
+		{
+			effect.phase_start = time;
+			StartBenchmarkPhase(effect);
+		}
+		else
+		{
+			LogBenchmarkResult("per-point search", effect.results[0]);
+			LogBenchmarkResult("collection grid", effect.results[1]);
+			GameOver();
+			return FX_Execute_Kill;
+		}
+	}
+	return FX_OK;
+}
+
+
+global func StartBenchmarkPhase(proplist effect)
+{
+	benchmark_legacy_collection = effect.phases[effect.phase];
+	benchmark_collection_time = 0;
+	GameCallEx("OnRoundStart", effect.phase + 1);
+}
+
+
+global func LogBenchmarkResult(string mode, int milliseconds)
+{
+	var microseconds = milliseconds * 1000 / BENCHMARK_Frames;
+	Log("Benchmark: %d spawn points, %d bots, %s: %d.%03d ms collection script time per frame", BENCHMARK_SpawnPoints, BENCHMARK_Bots, mode, microseconds / 1000, microseconds % 1000);
+}
@@ -0,0 +1,12 @@
+/**
+ Measures the time that the spawn point scheduler spends in collection.
+ */
+
+#appendto Arena_SpawnPointScheduler
+
+private func ExecuteCollection(int frame)
+{
+	var start = GetTime();
+	_inherited(frame, ...);
+	benchmark_collection_time += GetTime() - start;
+}
@@ -0,0 +1,31 @@
+/**
+ Measures the time that spawn points spend in collection, and switches
+ spawn points to their own collection effect for comparison.
+ */
+
+#appendto SpawnPoint
+
+private func StartSpawning()
+{
+	_inherited(...);
+	
+	if (benchmark_legacy_collection && spawn_collectible)
+	{
+		AddEffect(SPAWNPOINT_Effect_Collection, this, 1, 1, this);
+	}
+}
+
+private func UpdateCollection()
+{
+	if (!benchmark_legacy_collection)
+	{
+		_inherited(...);
+	}
+}
+
+private func FxIntSpawnCollectTimer(object target, proplist effect_nr, int timer)
+{
+	var start = GetTime();
+	_inherited(target, effect_nr, timer, ...);
+	benchmark_collection_time += GetTime() - start;
+}
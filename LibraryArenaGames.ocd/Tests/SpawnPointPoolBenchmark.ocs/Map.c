@@ -0,0 +1,9 @@
+/**
+ Flat ground, so that all spawn points can be placed at the same height, just above the surface.
+ */
+
+protected func InitializeMap(proplist map)
+{
+	map->Draw("Earth", nil, [0, map.Hgt / 2, map.Wdt, map.Hgt / 2]);
+	return true;
+}
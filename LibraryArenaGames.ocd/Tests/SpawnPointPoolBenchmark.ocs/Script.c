@@ -0,0 +1,88 @@
+/**
+ Benchmark for the spawn point pool.
+ 
+ Creates many spawn points and runs short rounds, first without pooling, then with
+ pooling. The number of objects that were created for each round is written to the log.
+ 
+ Run it headless, for example: openclonk --headless LibraryArenaGames.ocd/Tests/SpawnPointPoolBenchmark.ocs
+ 
+ @author Marky
+*/
+
+static const BENCHMARK_SpawnPoints = 500;
+static const BENCHMARK_Rounds = 10;      // rounds per mode
+static const BENCHMARK_RoundFrames = 50; // frames
+
+static benchmark_spawn_count; // int: number of spawned objects, see System.ocg/SpawnCount.c
+
+protected func Initialize()
+{
+	var ground = LandscapeHeight() / 2;
+
+	var template_item = CreateSpawnPoint(0, 0)->SetRespawnTimer(FRAME_Per_Second)->SpawnItem(Rock, nil, true);
+	var template_deco = CreateSpawnPoint(0, 0)->SetRespawnTimer(SPAWNPOINT_Timer_Infinite)->SpawnDeco(Grass);
+	for (var i = 0; i < BENCHMARK_SpawnPoints; i++)
+	{
+		var template = template_item;
+		if (i % 2) template = template_deco;
+
+		CopySpawnPoint(template, 10 + Random(LandscapeWidth() - 20), ground - 5);
+	}
+	template_item->RemoveObject();
+	template_deco->RemoveObject();
+	
+	benchmark_spawn_count = 0;
+	AddEffect("Benchmark", nil, 1, BENCHMARK_RoundFrames);
+	GameCallEx("OnRoundStart", 1);
+}
+
+
+global func FxBenchmarkStart(object target, proplist effect, int temp)
+{
+	if (temp) return;
+
+	effect.round = 1;
+	effect.created = 0;
+	effect.results = [];
+}
+
+
+global func FxBenchmarkTimer(object target, proplist effect, int time)
+{
+	GameCallEx("OnRoundEnd", effect.round);
+	
+	// every spawn that did not reuse an object created one
+	var created = benchmark_spawn_count - SpawnPointPool()->GetReusedCount();
+	PushBack(effect.results, created - effect.created);
+	effect.created = created;
+	
+	if (effect.round == BENCHMARK_Rounds)
+	{
+		for (var point in FindObjects(Find_ID(SpawnPoint)))
+		{
+			point->SetPooled(true);
+		}
+	}
+	else if (effect.round == 2 * BENCHMARK_Rounds)
+	{
+		LogBenchmarkResult("without pooling", effect.results[:BENCHMARK_Rounds]);
+		LogBenchmarkResult("with pooling", effect.results[BENCHMARK_Rounds:]);
+		GameOver();
+		return FX_Execute_Kill;
+	}
+
+	effect.round++;
+	GameCallEx("OnRoundStart", effect.round);
+	return FX_OK;
+}
+
+
+global func LogBenchmarkResult(string mode, array created)
+{
+	var total = 0;
+	for (var amount in created)
+	{
+		total += amount;
+	}
+	Log("Benchmark: %d spawn points, %s: %d objects created per round (%v)", BENCHMARK_SpawnPoints, mode, total / GetLength(created), created);
+}
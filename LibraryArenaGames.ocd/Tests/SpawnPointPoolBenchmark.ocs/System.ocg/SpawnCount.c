@@ -0,0 +1,10 @@
+/**
+ Counts the objects that spawn points spawn.
+ */
+
+#appendto SpawnPoint
+
+private func EffectSpawn(int index)
+{
+	benchmark_spawn_count++;
+}